@@ -0,0 +1,72 @@
+#ifndef BME280_COMPENSATION_H
+#define BME280_COMPENSATION_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// Pure compensation functions (no I2C access), usable on the device and on a host.
+
+// Calibration block, as stored in the CALIB00..CALIB41 registers
+typedef struct
+{
+    uint16_t dig_T1;
+    int16_t dig_T2;
+    int16_t dig_T3;
+
+    uint16_t dig_P1;
+    int16_t dig_P2;
+    int16_t dig_P3;
+    int16_t dig_P4;
+    int16_t dig_P5;
+    int16_t dig_P6;
+    int16_t dig_P7;
+    int16_t dig_P8;
+    int16_t dig_P9;
+
+    uint8_t dig_H1;
+    int16_t dig_H2;
+    uint8_t dig_H3;
+    int16_t dig_H4;
+    int16_t dig_H5;
+    int8_t dig_H6;
+} bme280_calib_t;
+
+// Raw samples in a struct-of-arrays layout, one entry per sample in each array
+typedef struct
+{
+    const int32_t *adc_T;
+    const int32_t *adc_P;
+    const int32_t *adc_H;
+    size_t count;
+} bme280_raw_batch_t;
+
+// One raw sample, as read in a single burst from PRESS_MSB_REG to HUM_LSB_REG
+typedef struct
+{
+    int32_t adc_T;
+    int32_t adc_P;
+    int32_t adc_H;
+} bme280_raw_t;
+
+// One compensated sample : temperature time 100 (°C), pressure Q24.8 (Pa), humidity Q22.10 (%)
+typedef struct
+{
+    int32_t temperature;
+    uint32_t pressure;
+    uint32_t humidity;
+} bme280_sample_t;
+
+void parse_calibration(const uint8_t *tp_buf, const uint8_t *h_buf, bme280_calib_t *calib);
+
+int32_t compensate_t_fine(const bme280_calib_t *calib, int32_t adc_T);
+int32_t compensate_temperature(int32_t t_fine);
+uint32_t compensate_pressure(const bme280_calib_t *calib, int32_t adc_P, int32_t t_fine);
+uint32_t compensate_humidity(const bme280_calib_t *calib, int32_t adc_H, int32_t t_fine);
+void compensate_sample(const bme280_calib_t *calib, const bme280_raw_t *raw, bme280_sample_t *sample);
+
+void compensate_temperature_batch(const bme280_calib_t *calib, const int32_t *adc_T, int32_t *t_fine, int32_t *temperature, size_t count);
+void compensate_pressure_batch(const bme280_calib_t *calib, const int32_t *adc_P, const int32_t *t_fine, uint32_t *pressure, size_t count);
+void compensate_humidity_batch(const bme280_calib_t *calib, const int32_t *adc_H, const int32_t *t_fine, uint32_t *humidity, size_t count);
+void compensate_batch(const bme280_calib_t *calib, const bme280_raw_batch_t *raw, int32_t *t_fine, int32_t *temperature, uint32_t *pressure, uint32_t *humidity);
+
+#endif
@@ -0,0 +1,24 @@
+#ifndef BME280_DERIVED_H
+#define BME280_DERIVED_H
+
+#include <stdint.h>
+
+// Derived quantities computed in fixed point from the compensated integer outputs:
+// pressure in Q24.8 Pa, temperature in 1/100 °C, humidity in Q22.10 %.
+
+#define SEA_LEVEL_PRESSURE_PA 101325
+
+// Altitude table : pressure ratio p/p0 from 0.25 to 1.25 by 1/256 steps
+#define ALTITUDE_TABLE_SIZE 257
+// Saturation vapour pressure table : -40 °C to 85 °C by 1 °C steps
+#define VAPOUR_TABLE_MIN_TEMP (-4000)
+#define VAPOUR_TABLE_MAX_TEMP 8500
+#define VAPOUR_TABLE_SIZE 126
+
+int32_t derive_altitude_mm(uint32_t pressure, uint32_t sea_level_pressure_pa);
+uint32_t derive_sea_level_pressure(uint32_t pressure, int32_t altitude_mm);
+uint32_t derive_saturation_vapour_pressure(int32_t temperature);
+int32_t derive_dew_point(int32_t temperature, uint32_t humidity);
+uint32_t derive_absolute_humidity(int32_t temperature, uint32_t humidity);
+
+#endif
@@ -4,14 +4,31 @@
 #include <stdio.h>
 #include "pico/stdlib.h"
 #include "hardware/i2c.h"
+#include "hardware/spi.h"
+#include "BME280_compensation.h"
 
 #define BME280
 
+// Transport used to talk to the sensor : TRANSPORT_I2C or TRANSPORT_SPI (4-wire)
+// Can be set from the build (-DTRANSPORT=1 or the BME280_USE_SPI CMake option)
+#define TRANSPORT_I2C 0
+#define TRANSPORT_SPI 1
+#ifndef TRANSPORT
+#define TRANSPORT TRANSPORT_I2C
+#endif
+
 #define I2C_PORT i2c1
 #define I2C_SDA 2
 #define I2C_SCL 3
 #define I2C_SPEED 100000
 
+#define SPI_PORT spi0
+#define SPI_MISO 16
+#define SPI_CS 17
+#define SPI_SCK 18
+#define SPI_MOSI 19
+#define SPI_SPEED 10000000
+
 #define ADDR _u(0x76)
 #define BME_280_ID _u(0x60)
 #define BMP_280_ID _u(0x58)
@@ -99,7 +116,7 @@
 #define PRESS_OVERSAMPLING_0_VALUE _u(0x00)
 #define PRESS_OVERSAMPLING_1_VALUE _u(0x04)
 #define PRESS_OVERSAMPLING_2_VALUE _u(0x08)
-#define PRESS_OVERSAMPLING_4_VALUE _u(0x0F)
+#define PRESS_OVERSAMPLING_4_VALUE _u(0x0C)
 #define PRESS_OVERSAMPLING_8_VALUE _u(0x10)
 #define PRESS_OVERSAMPLING_16_VALUE _u(0x14)
 
@@ -177,6 +194,8 @@ float get_humidity_percentage();
 #endif
 
 void init();
+void read_regs(uint8_t address, uint8_t *buf, size_t len);
+void write_reg(uint8_t address, uint8_t value);
 uint8_t read_reg(uint8_t address);
 void sensor_id();
 void print_uint8_binary(uint8_t value);
@@ -189,6 +208,10 @@ void set_standby(uint8_t standby);
 void set_iir_coefficent(uint8_t coefficent);
 void enable_spi();
 void disable_spi();
+void read_calibration(bme280_calib_t *calib);
+const bme280_calib_t *get_calibration();
+void get_raw_burst(bme280_raw_t *raw);
+uint32_t get_measurement_time_us();
 int32_t get_t_fine();
 uint32_t get_raw_press();
 uint32_t get_compensate_pressure();
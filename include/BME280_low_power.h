@@ -0,0 +1,31 @@
+#ifndef BME280_LOW_POWER_H
+#define BME280_LOW_POWER_H
+
+#include "pico/stdlib.h"
+#include "BME280_i2c.h"
+
+// Duty-cycled acquisition : one forced conversion per period, MCU and sensor asleep in between.
+typedef struct
+{
+    uint32_t period_ms;           // sampling period
+    uint32_t measurement_time_us; // conversion time for the current oversampling settings
+    uint8_t ctrl_meas;            // CTRL_MEAS_REG without the mode bits, to trigger with a single write
+    absolute_time_t next_sample;  // wake-up time of the next sample
+    uint8_t alarm;                // hardware timer alarm that wakes the core up
+
+    // Energy accounting
+    uint64_t awake_us;    // time spent with the core running, from every wake-up to the next sleep
+    uint64_t bus_us;      // time spent in sensor bus transfers
+    uint32_t samples;     // number of samples acquired
+    uint64_t awake_start; // time of the last wake-up
+} bme280_low_power_t;
+
+void low_power_init(bme280_low_power_t *lp, uint32_t period_ms);
+void low_power_update_measurement_time(bme280_low_power_t *lp);
+void low_power_set_oversampling(bme280_low_power_t *lp, uint8_t oversampling);
+void low_power_acquire(bme280_low_power_t *lp, bme280_sample_t *sample);
+void low_power_sleep(bme280_low_power_t *lp);
+void low_power_charge_bus(bme280_low_power_t *lp, uint64_t start_us);
+void low_power_reset_counters(bme280_low_power_t *lp);
+
+#endif
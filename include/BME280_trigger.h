@@ -0,0 +1,61 @@
+#ifndef BME280_TRIGGER_H
+#define BME280_TRIGGER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "BME280_compensation.h"
+
+// Event-driven sampling : per-channel thresholds and slope limits on the compensated stream,
+// sampling period shortened when a threshold is crossed or a value changes fast, relaxed when quiet.
+
+#define TRIGGER_TEMPERATURE 0
+#define TRIGGER_PRESSURE 1
+#define TRIGGER_HUMIDITY 2
+#define TRIGGER_CHANNELS 3
+
+// Channel configuration, in the units of bme280_sample_t (1/100 °C, Q24.8 Pa, Q22.10 %)
+typedef struct
+{
+    bool enabled;
+    int32_t low;        // event when the value goes below low
+    int32_t high;       // event when the value goes above high
+    int32_t hysteresis; // the value must come back inside [low + hysteresis, high - hysteresis] to end the event
+    int32_t max_slope;  // event when |variation| goes above max_slope per second (0 to disable)
+} trigger_channel_t;
+
+typedef struct
+{
+    trigger_channel_t channel[TRIGGER_CHANNELS];
+
+    // Adaptive sampling rate
+    uint32_t fast_period_ms;  // period after a trigger
+    uint32_t slow_period_ms;  // longest period when quiet
+    uint32_t quiet_samples;   // quiet samples before doubling the period
+    uint32_t slope_window_ms; // minimum age of the slope reference, keeps the sensor noise out of the slope
+    uint32_t period_ms;       // current period
+
+    // Internal state
+    bool in_event[TRIGGER_CHANNELS];  // value outside its thresholds (held until back inside the hysteresis)
+    bool in_slope[TRIGGER_CHANNELS];  // slope above max_slope on the last window
+    int32_t reference_value[TRIGGER_CHANNELS];
+    uint32_t reference_time_ms;
+    bool has_reference;
+    uint32_t quiet_count;
+
+    // Status
+    uint8_t status; // bit mask of the channels outside their thresholds (does not hold the fast rate)
+
+    // Counters
+    uint32_t samples;       // samples evaluated
+    uint32_t samples_saved; // samples not taken compared to sampling at fast_period_ms all the time
+    uint32_t events;        // threshold crossings and slope exceedances (rising edges only)
+} trigger_engine_t;
+
+void trigger_init(trigger_engine_t *engine, uint32_t fast_period_ms, uint32_t slow_period_ms, uint32_t quiet_samples, uint32_t slope_window_ms);
+void trigger_set_channel(trigger_engine_t *engine, uint8_t channel, int32_t low, int32_t high, int32_t hysteresis, int32_t max_slope);
+uint8_t trigger_evaluate(trigger_engine_t *engine, const bme280_sample_t *sample, uint32_t time_ms);
+bool trigger_adapt_rate(trigger_engine_t *engine, uint8_t fired);
+bool trigger_is_fast(const trigger_engine_t *engine);
+uint8_t trigger_status(const trigger_engine_t *engine);
+
+#endif
@@ -5,5 +5,7 @@
 #include "pico/stdlib.h"
 #include "hardware/i2c.h"
 #include "BME280_i2c.h"
+#include "BME280_low_power.h"
+#include "BME280_trigger.h"
 
 #endif
\ No newline at end of file
@@ -0,0 +1,205 @@
+#include "BME280_compensation.h"
+
+/**
+ * @brief Decode the calibration block from the raw register dumps.
+ *
+ * @param tp_buf 26 bytes read from CALIB00_REG (0x88..0xA1)
+ * @param h_buf 7 bytes read from CALIB26_REG (0xE1..0xE7)
+ * @param calib decoded calibration block
+ */
+void parse_calibration(const uint8_t *tp_buf, const uint8_t *h_buf, bme280_calib_t *calib)
+{
+    calib->dig_T1 = (uint16_t)(tp_buf[0] | (tp_buf[1] << 8));
+    calib->dig_T2 = (int16_t)(tp_buf[2] | (tp_buf[3] << 8));
+    calib->dig_T3 = (int16_t)(tp_buf[4] | (tp_buf[5] << 8));
+
+    calib->dig_P1 = (uint16_t)(tp_buf[6] | (tp_buf[7] << 8));
+    calib->dig_P2 = (int16_t)(tp_buf[8] | (tp_buf[9] << 8));
+    calib->dig_P3 = (int16_t)(tp_buf[10] | (tp_buf[11] << 8));
+    calib->dig_P4 = (int16_t)(tp_buf[12] | (tp_buf[13] << 8));
+    calib->dig_P5 = (int16_t)(tp_buf[14] | (tp_buf[15] << 8));
+    calib->dig_P6 = (int16_t)(tp_buf[16] | (tp_buf[17] << 8));
+    calib->dig_P7 = (int16_t)(tp_buf[18] | (tp_buf[19] << 8));
+    calib->dig_P8 = (int16_t)(tp_buf[20] | (tp_buf[21] << 8));
+    calib->dig_P9 = (int16_t)(tp_buf[22] | (tp_buf[23] << 8));
+
+    calib->dig_H1 = tp_buf[25];
+    calib->dig_H2 = (int16_t)(h_buf[0] | (h_buf[1] << 8));
+    calib->dig_H3 = h_buf[2];
+    // dig_H4 and dig_H5 are 12 bits signed values sharing the 0xE5 register
+    calib->dig_H4 = (int16_t)(((int16_t)(int8_t)h_buf[3] * 16) | (h_buf[4] & 0x0F));
+    calib->dig_H5 = (int16_t)(((int16_t)(int8_t)h_buf[5] * 16) | (h_buf[4] >> 4));
+    calib->dig_H6 = (int8_t)h_buf[6];
+}
+
+/**
+ * @brief Calculate the t_fine value used for the temperature, pressure and humidity calculation.
+ *
+ * @param calib calibration block
+ * @param adc_T raw temperature
+ * @return int32_t - t_fine
+ */
+int32_t compensate_t_fine(const bme280_calib_t *calib, int32_t adc_T)
+{
+    int32_t var_1;
+    int32_t var_2;
+    var_1 = ((((adc_T >> 3) - ((int32_t)calib->dig_T1 << 1))) * ((int32_t)calib->dig_T2)) >> 11;
+    var_2 = (((((adc_T >> 4) - ((int32_t)calib->dig_T1)) * ((adc_T >> 4) - ((int32_t)calib->dig_T1))) >> 12) * ((int32_t)calib->dig_T3)) >> 14;
+    return var_1 + var_2;
+}
+
+/**
+ * @brief Calculate the compensate temperature time 100 (20°C --> 2000)
+ *
+ * @param t_fine value returned by compensate_t_fine()
+ * @return int32_t - temperature
+ */
+int32_t compensate_temperature(int32_t t_fine)
+{
+    return ((t_fine * 5 + 128) >> 8);
+}
+
+/**
+ * @brief Calculate the compensate pressure, need to be divided by 256 to get Pa
+ *
+ * @param calib calibration block
+ * @param adc_P raw pressure
+ * @param t_fine value returned by compensate_t_fine()
+ * @return uint32_t - pressure (Q24.8 Pa)
+ */
+uint32_t compensate_pressure(const bme280_calib_t *calib, int32_t adc_P, int32_t t_fine)
+{
+    int64_t var1, var2, pressure;
+    var1 = ((int64_t)t_fine) - 128000;
+    var2 = var1 * var1 * (int64_t)calib->dig_P6;
+    var2 = var2 + ((var1 * (int64_t)calib->dig_P5) << 17);
+    var2 = var2 + (((int64_t)calib->dig_P4) << 35);
+    var1 = ((var1 * var1 * (int64_t)calib->dig_P3) >> 8) + ((var1 * (int64_t)calib->dig_P2) << 12);
+    var1 = (((((int64_t)1) << 47) + var1)) * ((int64_t)calib->dig_P1) >> 33;
+    if (var1 == 0)
+    {
+        return 0; // avoid exception caused by division by zero (datasheet)
+    }
+    pressure = 1048576 - adc_P;
+    pressure = (((pressure << 31) - var2) * 3125) / var1;
+    var1 = (((int64_t)calib->dig_P9) * (pressure >> 13) * (pressure >> 13)) >> 25;
+    var2 = (((int64_t)calib->dig_P8) * pressure) >> 19;
+    pressure = ((pressure + var1 + var2) >> 8) + (((int64_t)calib->dig_P7) << 4);
+    return ((uint32_t)pressure);
+}
+
+/**
+ * @brief Calculate the compensate humidity. Need to be divided by 1024.0 to have the humidity in %
+ *
+ * @param calib calibration block
+ * @param adc_H raw humidity
+ * @param t_fine value returned by compensate_t_fine()
+ * @return uint32_t - humidity (Q22.10 %)
+ */
+uint32_t compensate_humidity(const bme280_calib_t *calib, int32_t adc_H, int32_t t_fine)
+{
+    int32_t calculation = (t_fine - ((int32_t)76800));
+    calculation = (((((adc_H << 14) - (((int32_t)calib->dig_H4) << 20) - (((int32_t)calib->dig_H5) * calculation)) + ((int32_t)16384)) >> 15) * (((((((calculation * ((int32_t)calib->dig_H6)) >> 10) * (((calculation * ((int32_t)calib->dig_H3)) >> 11) + ((int32_t)32768))) >> 10) + ((int32_t)2097152)) * ((int32_t)calib->dig_H2) + 8192) >> 14));
+    calculation = (calculation - (((((calculation >> 15) * (calculation >> 15)) >> 7) * ((int32_t)calib->dig_H1)) >> 4));
+    calculation = (calculation < 0 ? 0 : calculation);
+    calculation = (calculation > 419430400 ? 419430400 : calculation);
+    return ((uint32_t)(calculation >> 12));
+}
+
+/**
+ * @brief Compensate the three channels of one raw sample, sharing a single t_fine calculation.
+ *
+ * @param calib calibration block
+ * @param raw raw sample
+ * @param sample compensated sample
+ */
+void compensate_sample(const bme280_calib_t *calib, const bme280_raw_t *raw, bme280_sample_t *sample)
+{
+    int32_t t_fine = compensate_t_fine(calib, raw->adc_T);
+    sample->temperature = compensate_temperature(t_fine);
+    sample->pressure = compensate_pressure(calib, raw->adc_P, t_fine);
+    sample->humidity = compensate_humidity(calib, raw->adc_H, t_fine);
+}
+
+/**
+ * @brief Temperature pass over an array of raw samples. Fills the t_fine array reused by the
+ * pressure and humidity passes.
+ *
+ * @param calib calibration block
+ * @param adc_T raw temperatures
+ * @param t_fine output t_fine values
+ * @param temperature output temperatures time 100, can be NULL if only t_fine is needed
+ * @param count number of samples
+ */
+void compensate_temperature_batch(const bme280_calib_t *calib, const int32_t *adc_T, int32_t *t_fine, int32_t *temperature, size_t count)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        t_fine[i] = compensate_t_fine(calib, adc_T[i]);
+    }
+    if (temperature != NULL)
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            temperature[i] = compensate_temperature(t_fine[i]);
+        }
+    }
+}
+
+/**
+ * @brief Pressure pass over an array of raw samples.
+ *
+ * @param calib calibration block
+ * @param adc_P raw pressures
+ * @param t_fine t_fine values from compensate_temperature_batch()
+ * @param pressure output pressures (Q24.8 Pa)
+ * @param count number of samples
+ */
+void compensate_pressure_batch(const bme280_calib_t *calib, const int32_t *adc_P, const int32_t *t_fine, uint32_t *pressure, size_t count)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        pressure[i] = compensate_pressure(calib, adc_P[i], t_fine[i]);
+    }
+}
+
+/**
+ * @brief Humidity pass over an array of raw samples.
+ *
+ * @param calib calibration block
+ * @param adc_H raw humidities
+ * @param t_fine t_fine values from compensate_temperature_batch()
+ * @param humidity output humidities (Q22.10 %)
+ * @param count number of samples
+ */
+void compensate_humidity_batch(const bme280_calib_t *calib, const int32_t *adc_H, const int32_t *t_fine, uint32_t *humidity, size_t count)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        humidity[i] = compensate_humidity(calib, adc_H[i], t_fine[i]);
+    }
+}
+
+/**
+ * @brief Run the temperature, pressure and humidity passes over a batch of raw samples.
+ * Every output array can be NULL (except t_fine) to skip the matching pass.
+ *
+ * @param calib calibration block
+ * @param raw raw samples
+ * @param t_fine output t_fine values (scratch buffer of raw->count entries)
+ * @param temperature output temperatures time 100
+ * @param pressure output pressures (Q24.8 Pa)
+ * @param humidity output humidities (Q22.10 %)
+ */
+void compensate_batch(const bme280_calib_t *calib, const bme280_raw_batch_t *raw, int32_t *t_fine, int32_t *temperature, uint32_t *pressure, uint32_t *humidity)
+{
+    compensate_temperature_batch(calib, raw->adc_T, t_fine, temperature, raw->count);
+    if (pressure != NULL)
+    {
+        compensate_pressure_batch(calib, raw->adc_P, t_fine, pressure, raw->count);
+    }
+    if (humidity != NULL)
+    {
+        compensate_humidity_batch(calib, raw->adc_H, t_fine, humidity, raw->count);
+    }
+}
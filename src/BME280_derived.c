@@ -0,0 +1,194 @@
+#include "BME280_derived.h"
+
+// Barometric formula h = 44330 * (1 - (p / p0)^(1 / 5.255)) in mm, for p / p0 = (64 + i) / 256
+static const int32_t altitude_table[ALTITUDE_TABLE_SIZE] = {
+    10279088, 10178477, 10079111, 9980957, 9883983, 9788156, 9693447, 9599828,
+    9507270, 9415747, 9325234, 9235706, 9147139, 9059511, 8972799, 8886984,
+    8802043, 8717957, 8634708, 8552277, 8470647, 8389799, 8309718, 8230387,
+    8151792, 8073916, 7996745, 7920266, 7844464, 7769326, 7694840, 7620993,
+    7547772, 7475167, 7403165, 7331755, 7260927, 7190670, 7120975, 7051830,
+    6983227, 6915156, 6847608, 6780573, 6714045, 6648013, 6582470, 6517407,
+    6452818, 6388693, 6325027, 6261811, 6199039, 6136703, 6074797, 6013315,
+    5952249, 5891595, 5831344, 5771493, 5712034, 5652962, 5594271, 5535956,
+    5478012, 5420434, 5363215, 5306352, 5249840, 5193673, 5137847, 5082357,
+    5027199, 4972368, 4917861, 4863672, 4809798, 4756235, 4702979, 4650025,
+    4597370, 4545011, 4492943, 4441163, 4389668, 4338454, 4287517, 4236854,
+    4186462, 4136338, 4086479, 4036881, 3987541, 3938457, 3889626, 3841044,
+    3792708, 3744617, 3696767, 3649156, 3601780, 3554638, 3507727, 3461044,
+    3414586, 3368353, 3322340, 3276545, 3230967, 3185603, 3140451, 3095509,
+    3050774, 3006244, 2961918, 2917793, 2873866, 2830137, 2786604, 2743263,
+    2700114, 2657154, 2614382, 2571796, 2529394, 2487174, 2445134, 2403273,
+    2361590, 2320081, 2278747, 2237585, 2196593, 2155770, 2115115, 2074625,
+    2034300, 1994138, 1954138, 1914297, 1874615, 1835090, 1795721, 1756507,
+    1717445, 1678535, 1639776, 1601166, 1562704, 1524388, 1486218, 1448192,
+    1410309, 1372568, 1334967, 1297505, 1260182, 1222996, 1185946, 1149031,
+    1112250, 1075601, 1039084, 1002698, 966441, 930313, 894312, 858437,
+    822689, 787065, 751564, 716186, 680930, 645794, 610778, 575882,
+    541103, 506441, 471896, 437466, 403151, 368949, 334860, 300883,
+    267017, 233262, 199617, 166080, 132651, 99329, 66114, 33004,
+    0, -32900, -65697, -98391, -130983, -163474, -195864, -228154,
+    -260344, -292436, -324431, -356328, -388128, -419833, -451442, -482957,
+    -514377, -545704, -576939, -608081, -639131, -670091, -700960, -731740,
+    -762430, -793032, -823546, -853972, -884311, -914564, -944731, -974813,
+    -1004810, -1034723, -1064552, -1094298, -1123961, -1153542, -1183042, -1212460,
+    -1241798, -1271055, -1300233, -1329332, -1358352, -1387294, -1416158, -1444945,
+    -1473655, -1502288, -1530846, -1559328, -1587736, -1616068, -1644327, -1672511,
+    -1700623, -1728662, -1756628, -1784522, -1812344, -1840096, -1867776, -1895386,
+    -1922927
+};
+
+// Magnus formula es = 611.2 * exp(17.62 * T / (243.12 + T)) in Q24.8 Pa, for T = -40 + i °C
+static const uint32_t vapour_table[VAPOUR_TABLE_SIZE] = {
+    4869, 5399, 5981, 6619, 7318, 8082, 8918, 9831,
+    10828, 11915, 13099, 14388, 15791, 17315, 18970, 20766,
+    22713, 24823, 27106, 29577, 32247, 35131, 38244, 41602,
+    45221, 49119, 53314, 57827, 62677, 67887, 73480, 79480,
+    85912, 92804, 100183, 108079, 116524, 125550, 135192, 145485,
+    156467, 168178, 180659, 193954, 208107, 223166, 239181, 256203,
+    274286, 293487, 313864, 335478, 358394, 382678, 408398, 435628,
+    464442, 494918, 527137, 561183, 597145, 635111, 675178, 717443,
+    762007, 808975, 858456, 910564, 965414, 1023129, 1083833, 1147657,
+    1214733, 1285200, 1359203, 1436887, 1518407, 1603920, 1693589, 1787581,
+    1886069, 1989233, 2097256, 2210328, 2328644, 2452406, 2581820, 2717100,
+    2858465, 3006141, 3160360, 3321361, 3489389, 3664695, 3847539, 4038186,
+    4236909, 4443990, 4659714, 4884377, 5118282, 5361738, 5615064, 5878585,
+    6152636, 6437559, 6733703, 7041429, 7361102, 7693099, 8037805, 8395612,
+    8766924, 9152152, 9551716, 9966046, 10395582, 10840773, 11302077, 11779962,
+    12274907, 12787399, 13317937, 13867029, 14435194, 15022960
+};
+
+/**
+ * @brief Calculate the altitude from the pressure with the barometric formula (table + linear interpolation).
+ * Error below 0.2 m over the table range (about -1900 m to 10000 m).
+ *
+ * @param pressure compensate pressure (Q24.8 Pa) as returned by get_compensate_pressure()
+ * @param sea_level_pressure_pa reference pressure at sea level in Pa (SEA_LEVEL_PRESSURE_PA by default)
+ * @return int32_t - altitude (mm)
+ */
+int32_t derive_altitude_mm(uint32_t pressure, uint32_t sea_level_pressure_pa)
+{
+    if (sea_level_pressure_pa == 0)
+    {
+        return 0;
+    }
+    // p / p0 in Q8.24, clamped to the table range [0.25, 1.25[
+    uint64_t quotient = ((uint64_t)pressure << 16) / sea_level_pressure_pa;
+    quotient = (quotient < (64u << 16) ? (64u << 16) : quotient);
+    quotient = (quotient >= (320u << 16) ? (320u << 16) - 1 : quotient);
+    uint32_t ratio = (uint32_t)quotient;
+
+    uint32_t index = (ratio >> 16) - 64;
+    int32_t frac = (int32_t)((ratio >> 4) & 0xFFF);
+    return altitude_table[index] + (((altitude_table[index + 1] - altitude_table[index]) * frac) >> 12);
+}
+
+/**
+ * @brief Reduce the station pressure to the sea level pressure, knowing the station altitude
+ * (inverse of derive_altitude_mm()). Error below 0.5 Pa for stations up to 3000 m.
+ *
+ * @param pressure compensate pressure (Q24.8 Pa) as returned by get_compensate_pressure()
+ * @param altitude_mm station altitude (mm)
+ * @return uint32_t - sea level pressure (Q24.8 Pa)
+ */
+uint32_t derive_sea_level_pressure(uint32_t pressure, int32_t altitude_mm)
+{
+    uint32_t low = 0;
+    uint32_t high = ALTITUDE_TABLE_SIZE - 1;
+
+    altitude_mm = (altitude_mm > altitude_table[low] ? altitude_table[low] : altitude_mm);
+    altitude_mm = (altitude_mm < altitude_table[high] ? altitude_table[high] : altitude_mm);
+
+    // The table is decreasing : altitude_table[low] >= altitude_mm >= altitude_table[high]
+    while (high - low > 1)
+    {
+        uint32_t middle = (low + high) >> 1;
+        if (altitude_table[middle] >= altitude_mm)
+        {
+            low = middle;
+        }
+        else
+        {
+            high = middle;
+        }
+    }
+    uint32_t frac = (uint32_t)(((altitude_table[low] - altitude_mm) << 12) / (altitude_table[low] - altitude_table[high]));
+    uint32_t ratio = ((low + 64) << 16) + (frac << 4);
+    return (uint32_t)(((uint64_t)pressure << 24) / ratio);
+}
+
+/**
+ * @brief Calculate the saturation vapour pressure over water (table + linear interpolation).
+ * Relative error below 0.12 %, clamped to the table range [-40 °C, 85 °C].
+ *
+ * @param temperature compensate temperature time 100 as returned by get_compensate_temperature()
+ * @return uint32_t - saturation vapour pressure (Q24.8 Pa)
+ */
+uint32_t derive_saturation_vapour_pressure(int32_t temperature)
+{
+    temperature = (temperature < VAPOUR_TABLE_MIN_TEMP ? VAPOUR_TABLE_MIN_TEMP : temperature);
+    temperature = (temperature > VAPOUR_TABLE_MAX_TEMP ? VAPOUR_TABLE_MAX_TEMP : temperature);
+
+    uint32_t offset = (uint32_t)(temperature - VAPOUR_TABLE_MIN_TEMP);
+    uint32_t index = offset / 100;
+    uint32_t frac = offset % 100;
+    if (index == VAPOUR_TABLE_SIZE - 1)
+    {
+        return vapour_table[index];
+    }
+    return vapour_table[index] + ((vapour_table[index + 1] - vapour_table[index]) * frac) / 100;
+}
+
+/**
+ * @brief Calculate the dew point by inverting the saturation vapour pressure table.
+ * Error below 0.05 °C against the Magnus formula, clamped to [-40 °C, 85 °C].
+ *
+ * @param temperature compensate temperature time 100 as returned by get_compensate_temperature()
+ * @param humidity compensate humidity (Q22.10 %) as returned by get_compensate_humidity()
+ * @return int32_t - dew point time 100 (°C)
+ */
+int32_t derive_dew_point(int32_t temperature, uint32_t humidity)
+{
+    // Actual vapour pressure e = RH * es(T), 100 % = 102400
+    uint32_t vapour = (uint32_t)(((uint64_t)derive_saturation_vapour_pressure(temperature) * humidity) / 102400);
+    uint32_t low = 0;
+    uint32_t high = VAPOUR_TABLE_SIZE - 1;
+
+    if (vapour <= vapour_table[low])
+    {
+        return VAPOUR_TABLE_MIN_TEMP;
+    }
+    if (vapour >= vapour_table[high])
+    {
+        return VAPOUR_TABLE_MAX_TEMP;
+    }
+    while (high - low > 1)
+    {
+        uint32_t middle = (low + high) >> 1;
+        if (vapour_table[middle] <= vapour)
+        {
+            low = middle;
+        }
+        else
+        {
+            high = middle;
+        }
+    }
+    return VAPOUR_TABLE_MIN_TEMP + (int32_t)(low * 100) +
+           (int32_t)(((vapour - vapour_table[low]) * 100) / (vapour_table[high] - vapour_table[low]));
+}
+
+/**
+ * @brief Calculate the absolute humidity (mass of water vapour per volume of air).
+ * Relative error below 0.1 % above 1 g/m3.
+ *
+ * @param temperature compensate temperature time 100 as returned by get_compensate_temperature()
+ * @param humidity compensate humidity (Q22.10 %) as returned by get_compensate_humidity()
+ * @return uint32_t - absolute humidity (mg/m3)
+ */
+uint32_t derive_absolute_humidity(int32_t temperature, uint32_t humidity)
+{
+    uint64_t vapour = ((uint64_t)derive_saturation_vapour_pressure(temperature) * humidity) / 102400;
+    // rho = e / (Rv * T) with Rv = 461.5 J/(kg.K) : 1e6 / 461.5 * 100 = 216685 (T in 1/100 K, e in Q24.8)
+    uint32_t temperature_ck = (uint32_t)((temperature < VAPOUR_TABLE_MIN_TEMP ? VAPOUR_TABLE_MIN_TEMP : temperature) + 27315);
+    return (uint32_t)((vapour * 216685) / ((uint64_t)temperature_ck << 8));
+}
@@ -1,12 +1,28 @@
 #include "BME280_i2c.h"
 /**
- * @brief Sensor initialisation with the right i2c interface and speed. Setting the right pins and internal pull-up.
+ * @brief Sensor initialisation with the selected transport (TRANSPORT in the .h file).
+ * I2C : right i2c interface and speed, pins and internal pull-up.
+ * SPI : 4-wire, mode 0, chip select driven by software. The sensor switches to SPI
+ * on the first falling edge of CSB and stays in SPI until the next power-on.
  *
  */
 void init()
 {
     stdio_init_all();
 
+#if TRANSPORT == TRANSPORT_SPI
+    // SPI Initialisation. Using it at 10MHz.
+    spi_init(SPI_PORT, SPI_SPEED);
+    spi_set_format(SPI_PORT, 8, SPI_CPOL_0, SPI_CPHA_0, SPI_MSB_FIRST);
+
+    gpio_set_function(SPI_SCK, GPIO_FUNC_SPI);
+    gpio_set_function(SPI_MOSI, GPIO_FUNC_SPI);
+    gpio_set_function(SPI_MISO, GPIO_FUNC_SPI);
+
+    gpio_init(SPI_CS);
+    gpio_set_dir(SPI_CS, GPIO_OUT);
+    gpio_put(SPI_CS, 1);
+#else
     // I2C Initialisation. Using it at 100kHz.
     i2c_init(I2C_PORT, I2C_SPEED);
 
@@ -14,6 +30,49 @@ void init()
     gpio_set_function(I2C_SCL, GPIO_FUNC_I2C);
     gpio_pull_up(I2C_SDA);
     gpio_pull_up(I2C_SCL);
+#endif
+}
+
+/**
+ * @brief Read consecutive registers in a single burst (the address auto-increments).
+ * On SPI, the register address is sent with bit 7 set (read).
+ *
+ * @param address first register that will be read
+ * @param buf destination
+ * @param len number of registers to read
+ */
+void read_regs(uint8_t address, uint8_t *buf, size_t len)
+{
+#if TRANSPORT == TRANSPORT_SPI
+    uint8_t reg = address | 0x80;
+    gpio_put(SPI_CS, 0);
+    spi_write_blocking(SPI_PORT, &reg, 1);
+    spi_read_blocking(SPI_PORT, 0, buf, len);
+    gpio_put(SPI_CS, 1);
+#else
+    i2c_write_blocking(I2C_PORT, ADDR, &address, 1, true);
+    i2c_read_blocking(I2C_PORT, ADDR, buf, len, false);
+#endif
+}
+
+/**
+ * @brief Write 1 Byte in a register's sensor.
+ * On SPI, the register address is sent with bit 7 cleared (write).
+ *
+ * @param address register that will be written
+ * @param value data to write
+ */
+void write_reg(uint8_t address, uint8_t value)
+{
+#if TRANSPORT == TRANSPORT_SPI
+    uint8_t data[2] = {(uint8_t)(address & 0x7F), value};
+    gpio_put(SPI_CS, 0);
+    spi_write_blocking(SPI_PORT, data, 2);
+    gpio_put(SPI_CS, 1);
+#else
+    uint8_t data[2] = {address, value};
+    i2c_write_blocking(I2C_PORT, ADDR, data, 2, false);
+#endif
 }
 
 /**
@@ -25,10 +84,8 @@ void init()
 
 uint8_t read_reg(uint8_t address)
 {
-    uint8_t dest = address;
     uint8_t data;
-    i2c_write_blocking(I2C_PORT, ADDR, &dest, 1, true);
-    i2c_read_blocking(I2C_PORT, ADDR, &data, 1, false);
+    read_regs(address, &data, 1);
     return data;
 }
 
@@ -76,8 +133,7 @@ void print_uint8_binary(uint8_t value)
  */
 void reset()
 {
-    uint8_t data[2] = {ID_REG, RESET_VALUE};
-    i2c_write_blocking(I2C_PORT, ADDR, data, 2, false);
+    write_reg(RESET_REG, RESET_VALUE);
 }
 
 /**
@@ -114,7 +170,7 @@ void set_humidity_oversampling(uint8_t oversampling)
         data[1] = HUM_OVERSAMPLING_0_VALUE;
         break;
     }
-    i2c_write_blocking(I2C_PORT, ADDR, data, 2, false);
+    write_reg(data[0], data[1]);
 }
 
 /**
@@ -129,8 +185,7 @@ void set_temperature_oversampling(uint8_t oversampling)
     data[0] = CTRL_MEAS_REG;
 
     // getting the current state of the register
-    i2c_write_blocking(I2C_PORT, ADDR, data, 1, false);
-    i2c_read_blocking(I2C_PORT, ADDR, &data[1], 1, false);
+    data[1] = read_reg(data[0]);
 
     data[1] &= 0x1F; // clear temperature oversampling bits [7:5]
 
@@ -159,7 +214,7 @@ void set_temperature_oversampling(uint8_t oversampling)
         // data[1] = TEMP_OVERSAMPLING_0_VALUE; Already put to 0;
         break;
     }
-    i2c_write_blocking(I2C_PORT, ADDR, data, 2, false);
+    write_reg(data[0], data[1]);
 }
 
 /**
@@ -174,8 +229,7 @@ void set_pressure_oversampling(uint8_t oversampling)
     data[0] = CTRL_MEAS_REG;
 
     // getting the current state of the register
-    i2c_write_blocking(I2C_PORT, ADDR, data, 1, false);
-    i2c_read_blocking(I2C_PORT, ADDR, &data[1], 1, false);
+    data[1] = read_reg(data[0]);
 
     data[1] &= 0xE3; // clear pressure oversampling bits [5:2]
 
@@ -204,7 +258,7 @@ void set_pressure_oversampling(uint8_t oversampling)
         // data[1] = PRESS_OVERSAMPLING_0_VALUE; Already put to 0;
         break;
     }
-    i2c_write_blocking(I2C_PORT, ADDR, data, 2, false);
+    write_reg(data[0], data[1]);
 }
 
 /**
@@ -219,14 +273,13 @@ void set_mode(uint8_t mode)
     data[0] = CTRL_MEAS_REG;
 
     // getting the current state of the register
-    i2c_write_blocking(I2C_PORT, ADDR, data, 1, false);
-    i2c_read_blocking(I2C_PORT, ADDR, &data[1], 1, false);
+    data[1] = read_reg(data[0]);
 
     // Applying a mask to that register to avoid data loose
     data[1] &= 0xFC;
     data[1] |= mode;
 
-    i2c_write_blocking(I2C_PORT, ADDR, data, 2, false);
+    write_reg(data[0], data[1]);
 }
 
 /**
@@ -244,11 +297,10 @@ void set_standby(uint8_t standby)
         data[0] = CONFIG_REG;
 
         // getting the current state of the register
-        i2c_write_blocking(I2C_PORT, ADDR, data, 1, false);
-        i2c_read_blocking(I2C_PORT, ADDR, &data[1], 1, false);
+        data[1] = read_reg(data[0]);
         data[1] &= 0x1F;
         data[1] |= standby;
-        i2c_write_blocking(I2C_PORT, ADDR, data, 2, false);
+        write_reg(data[0], data[1]);
     }
     else
     {
@@ -270,11 +322,10 @@ void set_iir_coefficent(uint8_t coefficent)
         data[0] = CONFIG_REG;
 
         // getting the current state of the register
-        i2c_write_blocking(I2C_PORT, ADDR, data, 1, false);
-        i2c_read_blocking(I2C_PORT, ADDR, &data[1], 1, false);
+        data[1] = read_reg(data[0]);
         data[1] &= 0xE3;
         data[1] |= coefficent;
-        i2c_write_blocking(I2C_PORT, ADDR, data, 2, false);
+        write_reg(data[0], data[1]);
     }
     else
     {
@@ -283,24 +334,28 @@ void set_iir_coefficent(uint8_t coefficent)
 }
 
 /**
- * @brief Enable the sensor's spi communication
+ * @brief Enable the sensor's 3-wire spi communication (spi3w_en). Not needed by the 4-wire SPI transport,
+ * does nothing in that build (3-wire mode would break its reads).
  * 
  */
 void enable_spi()
 {
+#if TRANSPORT == TRANSPORT_SPI
+    printf("3-wire spi not available with the 4-wire SPI transport\n");
+    return;
+#endif
     uint8_t data[2];
 
     data[0] = CONFIG_REG;
 
     // getting the current state of the register
-    i2c_write_blocking(I2C_PORT, ADDR, data, 1, false);
-    i2c_read_blocking(I2C_PORT, ADDR, &data[1], 1, false);
+    data[1] = read_reg(data[0]);
     data[1] |= 0x01;
-    i2c_write_blocking(I2C_PORT, ADDR, data, 2, false);
+    write_reg(data[0], data[1]);
 }
 
 /**
- * @brief Disable the sensor's spi communication 
+ * @brief Disable the sensor's 3-wire spi communication (spi3w_en), back to 4-wire SPI.
  * 
  */
 void disable_spi()
@@ -310,12 +365,97 @@ void disable_spi()
     data[0] = CONFIG_REG;
 
     // getting the current state of the register
-    i2c_write_blocking(I2C_PORT, ADDR, data, 1, false);
-    i2c_read_blocking(I2C_PORT, ADDR, &data[1], 1, false);
+    data[1] = read_reg(data[0]);
     data[1] &= ~(0x01);
-    i2c_write_blocking(I2C_PORT, ADDR, data, 2, false);
+    write_reg(data[0], data[1]);
+}
+
+
+/**
+ * @brief Read the whole calibration block (0x88..0xA1 and 0xE1..0xE7) in two bursts.
+ *
+ * @param calib decoded calibration block
+ */
+void read_calibration(bme280_calib_t *calib)
+{
+    uint8_t tp_buf[26];
+    uint8_t h_buf[7];
+    uint8_t reg = CALIB00_REG;
+    read_regs(reg, tp_buf, 26);
+    reg = CALIB26_REG;
+    read_regs(reg, h_buf, 7);
+    parse_calibration(tp_buf, h_buf, calib);
+}
+
+/**
+ * @brief Give the calibration block, read from the sensor on the first call only
+ * (the calibration is stored in the sensor's NVM and never changes).
+ *
+ * @return const bme280_calib_t* - calibration block
+ */
+const bme280_calib_t *get_calibration()
+{
+    static bme280_calib_t calib;
+    static bool calib_loaded = false;
+    if (!calib_loaded)
+    {
+        read_calibration(&calib);
+        calib_loaded = true;
+    }
+    return &calib;
+}
+
+/**
+ * @brief Read the pressure, temperature and humidity data registers (0xF7..0xFE) in a single burst,
+ * so the three values come from the same conversion.
+ *
+ * @param raw raw sample
+ */
+void get_raw_burst(bme280_raw_t *raw)
+{
+    uint8_t reg = PRESS_MSB_REG;
+    uint8_t buf[8];
+    read_regs(reg, buf, 8);
+    raw->adc_P = (int32_t)(((uint32_t)buf[0] << 12) | ((uint32_t)buf[1] << 4) | ((uint32_t)buf[2] >> 4));
+    raw->adc_T = (int32_t)(((uint32_t)buf[3] << 12) | ((uint32_t)buf[4] << 4) | ((uint32_t)buf[5] >> 4));
+    raw->adc_H = (int32_t)(((uint32_t)buf[6] << 8) | ((uint32_t)buf[7]));
 }
 
+/**
+ * @brief Convert an oversampling register field to the number of samples.
+ *
+ * @param osrs oversampling field [0..7]
+ * @return uint32_t - number of samples (0 if the measurement is skipped)
+ */
+static uint32_t oversampling_samples(uint8_t osrs)
+{
+    return (osrs == 0 ? 0 : (osrs >= 5 ? 16 : 1u << (osrs - 1)));
+}
+
+/**
+ * @brief Calculate the maximum measurement time for the current oversampling settings (datasheet, appendix B).
+ * Reads CTRL_HUM_REG and CTRL_MEAS_REG, so call it again after changing the oversampling.
+ *
+ * @return uint32_t - measurement time (us)
+ */
+uint32_t get_measurement_time_us()
+{
+    uint8_t osrs_h = read_reg(CTRL_HUM_REG) & 0x07;
+    uint8_t ctrl_meas = read_reg(CTRL_MEAS_REG);
+    uint8_t osrs_t = (ctrl_meas >> 5) & 0x07;
+    uint8_t osrs_p = (ctrl_meas >> 2) & 0x07;
+
+    uint32_t time_us = 1250 + 2300 * oversampling_samples(osrs_t);
+    if (osrs_p != 0)
+    {
+        time_us += 2300 * oversampling_samples(osrs_p) + 575;
+    }
+    if (osrs_h != 0)
+    {
+        time_us += 2300 * oversampling_samples(osrs_h) + 575;
+    }
+    return time_us;
+}
 
 /**
  * @brief Calculate the t_fine value used for the temperature, pressure and humidity calculation.
@@ -324,27 +464,7 @@ void disable_spi()
  */
 int32_t get_t_fine()
 {
-    uint16_t dig_T1 = 0;
-    int16_t dig_T2 = 0, dig_T3 = 0;
-    uint8_t address = CALIB00_REG;
-    int32_t t_fine;
-    // Getting the values from the CALIB registers.
-    uint8_t data[6];
-
-    i2c_write_blocking(I2C_PORT, ADDR, &address, 1, true);
-    i2c_read_blocking(I2C_PORT, ADDR, data, 6, false);
-
-    dig_T1 = (uint16_t)(data[0] | (data[1] << 8));
-    dig_T2 = (int16_t)(data[2] | (data[3] << 8));
-    dig_T3 = (int16_t)(data[1] | (data[5] << 8));
-
-    uint32_t raw_temp = get_raw_temp();
-    int32_t var_1;
-    int32_t var_2;
-    var_1 = ((((raw_temp >> 3) - ((long signed int)dig_T1 << 1))) * ((long signed int)dig_T2)) >> 11;
-    var_2 = (((((raw_temp >> 4) - ((long signed int)dig_T1)) * ((raw_temp >> 4) - ((long signed int)dig_T1))) >> 12) * ((long signed int)dig_T3)) >> 14;
-    t_fine = var_1 + var_2;
-    return t_fine;
+    return compensate_t_fine(get_calibration(), (int32_t)get_raw_temp());
 }
 
 // Pressure fonctions
@@ -359,8 +479,7 @@ uint32_t get_raw_press()
     uint32_t pressure = 0;
     uint8_t reg = PRESS_MSB_REG;
     uint8_t buf[3];
-    i2c_write_blocking(I2C_PORT, ADDR, &reg, 1, true);
-    i2c_read_blocking(I2C_PORT, ADDR, buf, 3, false);
+    read_regs(reg, buf, 3);
     pressure = ((uint32_t)buf[0] << 12) |
                ((uint32_t)buf[1] << 4) |
                ((uint32_t)buf[2] >> 4);
@@ -375,40 +494,7 @@ uint32_t get_raw_press()
  */
 uint32_t get_compensate_pressure()
 {
-    uint16_t dig_P1 = 0;
-    int16_t dig_P2 = 0, dig_P3 = 0, dig_P4 = 0, dig_P5 = 0,
-            dig_P6 = 0, dig_P7 = 0, dig_P8 = 0, dig_P9 = 0;
-    uint8_t buf[18];
-    uint8_t reg = CALIB06_REG;
-    i2c_write_blocking(I2C_PORT, ADDR, &reg, 1, true);
-    i2c_read_blocking(I2C_PORT, ADDR, buf, 18, false);
-    dig_P1 = (uint16_t)(buf[0] | (buf[1] << 8));
-    dig_P2 = (int16_t)(buf[2] | (buf[3] << 8));
-    dig_P3 = (int16_t)(buf[4] | (buf[5] << 8));
-    dig_P4 = (int16_t)(buf[6] | (buf[7] << 8));
-    dig_P5 = (int16_t)(buf[8] | (buf[9] << 8));
-    dig_P6 = (int16_t)(buf[10] | (buf[11] << 8));
-    dig_P7 = (int16_t)(buf[12] | (buf[13] << 8));
-    dig_P8 = (int16_t)(buf[14] | (buf[15] << 8));
-    dig_P9 = (int16_t)(buf[16] | (buf[17] << 8));
-
-    int64_t var1, var2, pressure;
-    var1 = ((int64_t)get_t_fine()) - 128000;
-    var2 = var1 * var1 * (int64_t)dig_P6;
-    var2 = var2 + ((var1 * (int64_t)dig_P5 << 17));
-    var2 = var2 + (((int64_t)dig_P4) << 35);
-    var1 = ((var1 * var1 * (int64_t)dig_P3) >> 8) + ((var1 * (int64_t)dig_P2) << 12);
-    var1 = (((((int64_t)1) << 47) + var1)) * ((int64_t)dig_P1) >> 33;
-    if (var1 == 0)
-    {
-        return 0; // avoid exception caused by division by zero (datasheet)
-    }
-    pressure = 1048576 - get_raw_press();
-    pressure = (((pressure << 31) - var2) * 3125) / var1;
-    var1 = (((int64_t)dig_P9) * (pressure >> 13) * (pressure >> 13)) >> 25;
-    var2 = (((int64_t)dig_P8) * pressure) >> 19;
-    pressure = ((pressure + var1 + var2) >> 8) + (((int64_t)dig_P7) << 4);
-    return ((uint32_t)pressure);
+    return compensate_pressure(get_calibration(), (int32_t)get_raw_press(), get_t_fine());
 }
 
 /**
@@ -434,9 +520,7 @@ uint32_t get_raw_temp(void)
     uint8_t buf[3];
     uint32_t temp;
 
-    i2c_write_blocking(I2C_PORT, ADDR, &reg, 1, true);
-
-    i2c_read_blocking(I2C_PORT, ADDR, buf, 3, false);
+    read_regs(reg, buf, 3);
 
     temp = ((uint32_t)buf[0] << 12) |
            ((uint32_t)buf[1] << 4) |
@@ -452,7 +536,7 @@ uint32_t get_raw_temp(void)
  */
 int32_t get_compensate_temperature()
 {
-    return (((get_t_fine()) * 5 + 128) >> 8);
+    return compensate_temperature(get_t_fine());
 }
 
 /**
@@ -477,8 +561,7 @@ uint32_t get_raw_humidity()
     uint32_t hum = 0;
     uint8_t reg = HUM_MSB_REG;
     uint8_t buf[2];
-    i2c_write_blocking(I2C_PORT, ADDR, &reg, 1, true);
-    i2c_read_blocking(I2C_PORT, ADDR, buf, 2, false);
+    read_regs(reg, buf, 2);
 
     hum = ((uint32_t)buf[0] << 8) |
           ((uint32_t)buf[1]);
@@ -494,27 +577,7 @@ uint32_t get_raw_humidity()
  */
 uint32_t get_compensate_humidity()
 {
-    uint8_t reg = CALIB25_REG;
-    uint8_t dig_H1, dig_H3;
-    int16_t dig_H2, dig_H4, dig_H5;
-    int8_t dig_H6;
-    i2c_write_blocking(I2C_PORT, ADDR, &reg, 1, true);
-    i2c_read_blocking(I2C_PORT, ADDR, &dig_H1, 1, false);
-    reg = CALIB26_REG;
-    uint8_t buf[8];
-    i2c_write_blocking(I2C_PORT, ADDR, &reg, 1, true);
-    i2c_read_blocking(I2C_PORT, ADDR, buf, 8, false);
-    dig_H2 = (int16_t)(buf[0] | buf[1] << 8);
-    dig_H3 = buf[2];
-    dig_H4 = (int16_t)(((int16_t)buf[3] << 4) | (buf[4] & 0x0F));
-    dig_H5 = (int16_t)(((int16_t)buf[6] << 4) | ((buf[5] & 0xF0) >> 4));
-    dig_H6 = (int8_t)buf[7];
-    int32_t calculation = (get_t_fine() - ((int32_t)76800));
-    calculation = (((((get_raw_humidity() << 14 ) - (((int32_t)dig_H4) << 20) - (((int32_t)dig_H5) * calculation)) + ((int32_t)16384)) >> 15 ) * ((((((( calculation * ((int32_t)dig_H6)) >> 10) * ((( calculation * ((int32_t)dig_H3)) >> 11 ) + ((int32_t)32768))) >> 10 ) + ((int32_t)2097152)) * ((int32_t)dig_H2) + 8192 ) >> 14));
-    calculation = (calculation - ((((( calculation >> 15) * (calculation >> 15)) >> 7) * ((int32_t)dig_H1)) >> 4));
-    calculation = (calculation < 0 ? 0 : calculation);
-    calculation = (calculation > 419430400 ? 419430400 : calculation);
-    return ((uint32_t)(calculation >> 12)); 
+    return compensate_humidity(get_calibration(), (int32_t)get_raw_humidity(), get_t_fine());
 }
 
 /**
@@ -0,0 +1,182 @@
+#include "hardware/clocks.h"
+#include "hardware/structs/scb.h"
+#include "hardware/sync.h"
+#include "hardware/timer.h"
+#include "BME280_low_power.h"
+
+// Clocks left running while the core sleeps : the timer wakes it up, the UART finishes sending
+#define SLEEP_CLOCKS_EN0 0
+#define SLEEP_CLOCKS_EN1 (CLOCKS_SLEEP_EN1_CLK_SYS_TIMER_BITS | CLOCKS_SLEEP_EN1_CLK_SYS_UART0_BITS | CLOCKS_SLEEP_EN1_CLK_PERI_UART0_BITS)
+
+static volatile bool alarm_fired = false;
+
+static void low_power_alarm_callback(uint alarm_num)
+{
+    (void)alarm_num;
+    alarm_fired = true;
+}
+
+/**
+ * @brief Sleep until target : every clock but the timer and UART ones is gated (SLEEP_EN registers
+ * with SLEEPDEEP) and the core waits in WFI for the hardware alarm. The clock gating is restored on wake-up.
+ *
+ * @param lp acquisition state
+ * @param target wake-up time
+ */
+static void low_power_wait_until(const bme280_low_power_t *lp, absolute_time_t target)
+{
+    alarm_fired = false;
+    if (hardware_alarm_set_target(lp->alarm, target))
+    {
+        // Already past
+        return;
+    }
+
+    uint32_t sleep_en0 = clocks_hw->sleep_en0;
+    uint32_t sleep_en1 = clocks_hw->sleep_en1;
+    clocks_hw->sleep_en0 = SLEEP_CLOCKS_EN0;
+    clocks_hw->sleep_en1 = SLEEP_CLOCKS_EN1;
+    scb_hw->scr |= M0PLUS_SCR_SLEEPDEEP_BITS;
+
+    // Interrupts masked between the test and WFI so the alarm cannot be missed, WFI still wakes on it
+    uint32_t status = save_and_disable_interrupts();
+    while (!alarm_fired)
+    {
+        __wfi();
+        restore_interrupts(status);
+        status = save_and_disable_interrupts();
+    }
+    restore_interrupts(status);
+
+    scb_hw->scr &= ~M0PLUS_SCR_SLEEPDEEP_BITS;
+    clocks_hw->sleep_en0 = sleep_en0;
+    clocks_hw->sleep_en1 = sleep_en1;
+}
+
+/**
+ * @brief Initialise the duty-cycled acquisition. The sensor must already be configured
+ * (oversampling, filter) and left in SLEEP_MODE.
+ *
+ * @param lp acquisition state
+ * @param period_ms sampling period (ms)
+ */
+void low_power_init(bme280_low_power_t *lp, uint32_t period_ms)
+{
+    lp->period_ms = period_ms;
+    lp->next_sample = get_absolute_time();
+    lp->alarm = (uint8_t)hardware_alarm_claim_unused(true);
+    hardware_alarm_set_callback(lp->alarm, low_power_alarm_callback);
+    low_power_reset_counters(lp);
+    low_power_update_measurement_time(lp);
+    // Loaded now so the first sample does not pay for the calibration reading
+    get_calibration();
+}
+
+/**
+ * @brief Read the oversampling settings back from the sensor to compute the conversion time
+ * and cache CTRL_MEAS_REG. Call it after every oversampling change (done by low_power_set_oversampling()).
+ *
+ * @param lp acquisition state
+ */
+void low_power_update_measurement_time(bme280_low_power_t *lp)
+{
+    uint64_t start = time_us_64();
+    lp->ctrl_meas = read_reg(CTRL_MEAS_REG) & 0xFC;
+    lp->measurement_time_us = get_measurement_time_us();
+    low_power_charge_bus(lp, start);
+}
+
+/**
+ * @brief Apply the same oversampling to the three channels and update the conversion time.
+ * The bus traffic is counted in bus_us.
+ *
+ * @param lp acquisition state
+ * @param oversampling [0,1,2,4,8,16]
+ */
+void low_power_set_oversampling(bme280_low_power_t *lp, uint8_t oversampling)
+{
+    uint64_t start = time_us_64();
+    set_humidity_oversampling(oversampling); // Applied on the next CTRL_MEAS write
+    set_pressure_oversampling(oversampling);
+    set_temperature_oversampling(oversampling);
+    low_power_charge_bus(lp, start);
+    low_power_update_measurement_time(lp);
+}
+
+/**
+ * @brief Acquire one sample : trigger a forced conversion, sleep (clocks gated) during the conversion time,
+ * read the three channels in one burst and compensate them.
+ * The sensor goes back to SLEEP_MODE by itself at the end of a forced conversion.
+ *
+ * @param lp acquisition state
+ * @param sample compensated sample
+ */
+void low_power_acquire(bme280_low_power_t *lp, bme280_sample_t *sample)
+{
+    bme280_raw_t raw;
+    uint64_t start = time_us_64();
+
+    // Single capture, one write thanks to the cached register
+    write_reg(CTRL_MEAS_REG, lp->ctrl_meas | FORCED_MODE);
+    uint64_t triggered = time_us_64();
+    lp->bus_us += triggered - start;
+    lp->awake_us += triggered - lp->awake_start;
+
+    // The conversion starts at the end of the write
+    low_power_wait_until(lp, delayed_by_us(from_us_since_boot(triggered), lp->measurement_time_us));
+
+    lp->awake_start = time_us_64();
+    get_raw_burst(&raw);
+    low_power_charge_bus(lp, lp->awake_start);
+
+    compensate_sample(get_calibration(), &raw, sample);
+    lp->samples++;
+}
+
+/**
+ * @brief Sleep (clocks gated) until the next sampling period. The wake-up time is kept on an absolute
+ * schedule so the acquisition and printing time do not make the period drift.
+ * Everything done since the last wake-up (printing, trigger evaluation...) is counted in awake_us.
+ *
+ * @param lp acquisition state
+ */
+void low_power_sleep(bme280_low_power_t *lp)
+{
+    uint64_t now = time_us_64();
+    lp->awake_us += now - lp->awake_start;
+    lp->awake_start = now;
+
+    lp->next_sample = delayed_by_ms(lp->next_sample, lp->period_ms);
+    if (absolute_time_diff_us(get_absolute_time(), lp->next_sample) <= 0)
+    {
+        // Late (period shorter than the acquisition), restart the schedule from now
+        lp->next_sample = get_absolute_time();
+        return;
+    }
+    low_power_wait_until(lp, lp->next_sample);
+    lp->awake_start = time_us_64();
+}
+
+/**
+ * @brief Count a bus transfer made outside of this module in bus_us (time from start_us to now).
+ *
+ * @param lp acquisition state
+ * @param start_us time_us_64() at the beginning of the transfer
+ */
+void low_power_charge_bus(bme280_low_power_t *lp, uint64_t start_us)
+{
+    lp->bus_us += time_us_64() - start_us;
+}
+
+/**
+ * @brief Reset the energy accounting counters.
+ *
+ * @param lp acquisition state
+ */
+void low_power_reset_counters(bme280_low_power_t *lp)
+{
+    lp->awake_us = 0;
+    lp->bus_us = 0;
+    lp->samples = 0;
+    lp->awake_start = time_us_64();
+}
@@ -0,0 +1,198 @@
+#include <stdio.h>
+#include "BME280_trigger.h"
+
+/**
+ * @brief Initialise the trigger engine with every channel disabled, sampling at the slow period.
+ *
+ * @param engine trigger engine
+ * @param fast_period_ms period after a trigger (ms)
+ * @param slow_period_ms longest period when quiet (ms)
+ * @param quiet_samples number of quiet samples before doubling the period
+ * @param slope_window_ms minimum time between the two values of a slope (ms), long enough
+ * for the variation at max_slope to stand out of the sensor noise
+ */
+void trigger_init(trigger_engine_t *engine, uint32_t fast_period_ms, uint32_t slow_period_ms, uint32_t quiet_samples, uint32_t slope_window_ms)
+{
+    for (uint8_t i = 0; i < TRIGGER_CHANNELS; i++)
+    {
+        engine->channel[i].enabled = false;
+        engine->in_event[i] = false;
+        engine->in_slope[i] = false;
+        engine->reference_value[i] = 0;
+    }
+    engine->fast_period_ms = (fast_period_ms == 0 ? 1 : fast_period_ms);
+    engine->slow_period_ms = (slow_period_ms < engine->fast_period_ms ? engine->fast_period_ms : slow_period_ms);
+    engine->quiet_samples = quiet_samples;
+    engine->slope_window_ms = slope_window_ms;
+    engine->period_ms = engine->slow_period_ms;
+    engine->reference_time_ms = 0;
+    engine->has_reference = false;
+    engine->quiet_count = 0;
+    engine->status = 0;
+    engine->samples = 0;
+    engine->samples_saved = 0;
+    engine->events = 0;
+}
+
+/**
+ * @brief Configure and enable one channel.
+ *
+ * @param engine trigger engine
+ * @param channel TRIGGER_TEMPERATURE, TRIGGER_PRESSURE or TRIGGER_HUMIDITY
+ * @param low event when the value goes below low
+ * @param high event when the value goes above high
+ * @param hysteresis margin to come back inside the thresholds to end the event
+ * @param max_slope maximum variation per second (0 to disable)
+ */
+void trigger_set_channel(trigger_engine_t *engine, uint8_t channel, int32_t low, int32_t high, int32_t hysteresis, int32_t max_slope)
+{
+    if (channel >= TRIGGER_CHANNELS)
+    {
+        printf("Wrong trigger channel\n");
+        return;
+    }
+    engine->channel[channel].enabled = true;
+    engine->channel[channel].low = low;
+    engine->channel[channel].high = high;
+    engine->channel[channel].hysteresis = hysteresis;
+    engine->channel[channel].max_slope = max_slope;
+    engine->in_event[channel] = false;
+    engine->in_slope[channel] = false;
+    engine->status &= (uint8_t)~(1 << channel);
+}
+
+/**
+ * @brief Evaluate the thresholds (with hysteresis) and the slope limits on a new sample.
+ * A channel fires when its value crosses a threshold (edge only, staying outside does not fire
+ * again, see trigger_status()) or while its slope is above max_slope. The slope is measured
+ * against a reference at least slope_window_ms old, then the reference moves to the new sample.
+ *
+ * @param engine trigger engine
+ * @param sample compensated sample
+ * @param time_ms sample time (ms)
+ * @return uint8_t - bit mask of the channels that fired (1 << TRIGGER_xxx)
+ */
+uint8_t trigger_evaluate(trigger_engine_t *engine, const bme280_sample_t *sample, uint32_t time_ms)
+{
+    int32_t value[TRIGGER_CHANNELS];
+    uint8_t fired = 0;
+    uint32_t elapsed_ms = time_ms - engine->reference_time_ms;
+    bool slope_window = engine->has_reference && elapsed_ms != 0 && elapsed_ms >= engine->slope_window_ms;
+
+    value[TRIGGER_TEMPERATURE] = sample->temperature;
+    value[TRIGGER_PRESSURE] = (int32_t)sample->pressure;
+    value[TRIGGER_HUMIDITY] = (int32_t)sample->humidity;
+
+    for (uint8_t i = 0; i < TRIGGER_CHANNELS; i++)
+    {
+        const trigger_channel_t *channel = &engine->channel[i];
+        if (!channel->enabled)
+        {
+            continue;
+        }
+
+        if (!engine->in_event[i])
+        {
+            if (value[i] > channel->high || value[i] < channel->low)
+            {
+                engine->in_event[i] = true;
+                engine->events++;
+                fired |= (uint8_t)(1 << i);
+            }
+        }
+        else if (value[i] < channel->high - channel->hysteresis && value[i] > channel->low + channel->hysteresis)
+        {
+            engine->in_event[i] = false;
+        }
+
+        if (channel->max_slope != 0 && slope_window)
+        {
+            // |delta| / (elapsed_ms / 1000) > max_slope, without division
+            int64_t delta = (int64_t)value[i] - engine->reference_value[i];
+            delta = (delta < 0 ? -delta : delta);
+            bool slope_exceeded = (delta * 1000 > (int64_t)channel->max_slope * elapsed_ms);
+            if (slope_exceeded && !engine->in_slope[i])
+            {
+                engine->events++;
+            }
+            engine->in_slope[i] = slope_exceeded;
+        }
+
+        if (engine->in_slope[i])
+        {
+            fired |= (uint8_t)(1 << i);
+        }
+        if (engine->in_event[i])
+        {
+            engine->status |= (uint8_t)(1 << i);
+        }
+        else
+        {
+            engine->status &= (uint8_t)~(1 << i);
+        }
+    }
+
+    if (slope_window || !engine->has_reference)
+    {
+        for (uint8_t i = 0; i < TRIGGER_CHANNELS; i++)
+        {
+            engine->reference_value[i] = value[i];
+        }
+        engine->reference_time_ms = time_ms;
+        engine->has_reference = true;
+    }
+    return fired;
+}
+
+/**
+ * @brief Adapt the sampling period : fast period as soon as a channel fires,
+ * period doubled (up to the slow period) after quiet_samples quiet samples.
+ * Counts the samples saved compared to sampling at the fast period all the time.
+ *
+ * @param engine trigger engine
+ * @param fired value returned by trigger_evaluate()
+ * @return true - the period changed (sensor settings should follow)
+ */
+bool trigger_adapt_rate(trigger_engine_t *engine, uint8_t fired)
+{
+    uint32_t previous = engine->period_ms;
+
+    engine->samples++;
+    // This sample stands for period_ms / fast_period_ms samples at the fast rate
+    engine->samples_saved += engine->period_ms / engine->fast_period_ms - 1;
+
+    if (fired != 0)
+    {
+        engine->period_ms = engine->fast_period_ms;
+        engine->quiet_count = 0;
+    }
+    else if (++engine->quiet_count >= engine->quiet_samples)
+    {
+        engine->period_ms = (engine->period_ms > engine->slow_period_ms / 2 ? engine->slow_period_ms : engine->period_ms * 2);
+        engine->quiet_count = 0;
+    }
+    return engine->period_ms != previous;
+}
+
+/**
+ * @brief Tell if the engine is sampling at the fast period (right after a trigger).
+ *
+ * @param engine trigger engine
+ * @return true - fast period
+ */
+bool trigger_is_fast(const trigger_engine_t *engine)
+{
+    return engine->period_ms == engine->fast_period_ms;
+}
+
+/**
+ * @brief Give the channels currently outside their thresholds (held until the value comes back
+ * inside the hysteresis). Reported only, it does not hold the fast rate.
+ *
+ * @param engine trigger engine
+ * @return uint8_t - bit mask of the channels outside their thresholds (1 << TRIGGER_xxx)
+ */
+uint8_t trigger_status(const trigger_engine_t *engine)
+{
+    return engine->status;
+}
@@ -1,28 +1,51 @@
 #include "main.h"
 
+#define FAST_PERIOD_MS 100
+#define SLOW_PERIOD_MS 1000
+#define QUIET_SAMPLES 10
+#define SLOPE_WINDOW_MS 1000
+#define EVENT_OVERSAMPLING 4
+#define QUIET_OVERSAMPLING 1
+
 int main()
 {
-    float temp;
-    float press;
-    float hum;
+    bme280_low_power_t lp;
+    bme280_sample_t sample;
+    trigger_engine_t trigger;
     init();
     sleep_ms(1000);
-    set_pressure_oversampling(1);
-    set_temperature_oversampling(1);
     set_mode(SLEEP_MODE);
+    low_power_init(&lp, SLOW_PERIOD_MS);
+    low_power_set_oversampling(&lp, QUIET_OVERSAMPLING);
+
+    trigger_init(&trigger, FAST_PERIOD_MS, SLOW_PERIOD_MS, QUIET_SAMPLES, SLOPE_WINDOW_MS);
+    // 0 °C .. 35 °C, 0.5 °C hysteresis, 1 °C/s
+    trigger_set_channel(&trigger, TRIGGER_TEMPERATURE, 0, 3500, 50, 100);
+    // No pressure threshold, 50 Pa/s measured over SLOPE_WINDOW_MS
+    trigger_set_channel(&trigger, TRIGGER_PRESSURE, 0, INT32_MAX, 0, 50 * 256);
+    // 20 % .. 80 %, 2 % hysteresis, 2 %/s
+    trigger_set_channel(&trigger, TRIGGER_HUMIDITY, 20 * 1024, 80 * 1024, 2 * 1024, 2 * 1024);
+
     while (true)
     {
-        set_mode(FORCED_MODE);// Single capture 
-        sleep_ms(10);
+        low_power_acquire(&lp, &sample);
+        uint8_t fired = trigger_evaluate(&trigger, &sample, to_ms_since_boot(get_absolute_time()));
+        if (trigger_adapt_rate(&trigger, fired))
+        {
+            lp.period_ms = trigger.period_ms;
+            low_power_set_oversampling(&lp, trigger_is_fast(&trigger) ? EVENT_OVERSAMPLING : QUIET_OVERSAMPLING);
+        }
 
-        temp = get_temp_celsius();
-        press = get_pressure_in_Pa();
-        hum = get_humidity_percentage();
-        printf("Temperature : %.2f °C\n", temp);
-        printf("Pressure : %.2f Pa\n", press);
-        printf("Humidity : %.2f %%\n", hum);
-        sleep_ms(1000);
+        printf("Temperature : %.2f °C\n", sample.temperature / 100.0f);
+        printf("Pressure : %.2f Pa\n", sample.pressure / 256.0f);
+        printf("Humidity : %.2f %%\n", sample.humidity / 1024.0f);
+        printf("Awake : %lu us/sample, bus : %lu us/sample\n",
+               (unsigned long)(lp.awake_us / lp.samples), (unsigned long)(lp.bus_us / lp.samples));
+        printf("Period : %lu ms, out of range : 0x%x, events : %lu, samples saved : %lu\n",
+               (unsigned long)trigger.period_ms, trigger_status(&trigger),
+               (unsigned long)trigger.events, (unsigned long)trigger.samples_saved);
+        low_power_sleep(&lp);
     }
 
     return 0;
-}
\ No newline at end of file
+}
@@ -0,0 +1,70 @@
+#include <stdio.h>
+#include <math.h>
+#include "pico/stdlib.h"
+#include "hardware/structs/systick.h"
+#include "BME280_derived.h"
+
+// Cycle benchmark of the derived quantities on the device, against the soft-float
+// powf / logf formulas they replace. SysTick counts down from 0xFFFFFF at the core clock.
+
+#define ITERATIONS 1000
+
+static volatile int32_t sink;
+static volatile float sink_float;
+
+static uint32_t systick_start()
+{
+    systick_hw->rvr = 0x00FFFFFF;
+    systick_hw->cvr = 0;
+    systick_hw->csr = 0x5; // enabled, processor clock
+    return systick_hw->cvr;
+}
+
+static uint32_t systick_elapsed(uint32_t start)
+{
+    return (start - systick_hw->cvr) & 0x00FFFFFF;
+}
+
+static void report(const char *name, uint32_t cycles, uint64_t time_us)
+{
+    printf("%-28s %5lu cycles/call, %6.3f us/call\n", name,
+           (unsigned long)(cycles / ITERATIONS), (double)time_us / ITERATIONS);
+}
+
+#define BENCHMARK(name, expression)                      \
+    do                                                   \
+    {                                                    \
+        uint64_t time_start = time_us_64();              \
+        uint32_t start = systick_start();                \
+        for (uint32_t i = 0; i < ITERATIONS; i++)        \
+        {                                                \
+            expression;                                  \
+        }                                                \
+        uint32_t cycles = systick_elapsed(start);        \
+        report(name, cycles, time_us_64() - time_start); \
+    } while (0)
+
+int main()
+{
+    stdio_init_all();
+    sleep_ms(1000);
+
+    BENCHMARK("derive_altitude_mm", sink = derive_altitude_mm(25000000 + i * 97, SEA_LEVEL_PRESSURE_PA));
+    BENCHMARK("derive_sea_level_pressure", sink = (int32_t)derive_sea_level_pressure(25000000, (int32_t)(i * 997)));
+    BENCHMARK("derive_saturation_vapour", sink = (int32_t)derive_saturation_vapour_pressure((int32_t)(i * 7)));
+    BENCHMARK("derive_dew_point", sink = derive_dew_point(2000 + (int32_t)i, 20480 + i * 61));
+    BENCHMARK("derive_absolute_humidity", sink = (int32_t)derive_absolute_humidity(2000 + (int32_t)i, 20480 + i * 61));
+
+    BENCHMARK("powf altitude", sink_float = 44330.0f * (1.0f - powf((25000000 + i * 97) / 256.0f / 101325.0f, 0.1903f)));
+    BENCHMARK("logf dew point", {
+        float gamma = logf((20480 + i * 61) / 102400.0f) + 17.62f * (20.0f + i / 100.0f) / (243.12f + 20.0f + i / 100.0f);
+        sink_float = 243.12f * gamma / (17.62f - gamma);
+    });
+
+    while (true)
+    {
+        sleep_ms(1000);
+    }
+
+    return 0;
+}
@@ -0,0 +1,198 @@
+#include "bme280_sim.h"
+#include "BME280_i2c.h"
+
+uint8_t sim_regs[256];
+uint32_t sim_resets;
+uint32_t sim_bus_errors;
+uint32_t sim_transactions;
+
+i2c_inst_t sim_i2c1 = {1};
+spi_inst_t sim_spi0 = {0};
+
+static uint8_t pointer;
+
+// SPI frame state : first byte is the address (bit 7 set = read), then data
+#define SPI_IDLE 0
+#define SPI_ADDRESS 1
+#define SPI_READ 2
+#define SPI_WRITE 3
+static int spi_state = SPI_IDLE;
+
+/**
+ * @brief Power-on state : everything cleared, chip ID set.
+ *
+ */
+void sim_power_on(void)
+{
+    for (int i = 0; i < 256; i++)
+    {
+        sim_regs[i] = 0;
+    }
+    sim_regs[ID_REG] = BME_280_ID;
+    sim_resets = 0;
+    sim_bus_errors = 0;
+    sim_transactions = 0;
+    pointer = 0;
+    spi_state = SPI_IDLE;
+}
+
+/**
+ * @brief Register write as done by the sensor : ID and data registers are read-only,
+ * 0xB6 in RESET_REG resets the sensor.
+ *
+ * @param reg register address
+ * @param value written value
+ */
+static void sim_write(uint8_t reg, uint8_t value)
+{
+    if (reg == RESET_REG)
+    {
+        if (value == RESET_VALUE)
+        {
+            sim_resets++;
+        }
+        return;
+    }
+    if (reg == ID_REG || reg >= PRESS_MSB_REG)
+    {
+        return;
+    }
+    sim_regs[reg] = value;
+}
+
+bool stdio_init_all(void)
+{
+    return true;
+}
+
+void gpio_init(unsigned int gpio)
+{
+    (void)gpio;
+}
+
+void gpio_set_dir(unsigned int gpio, bool out)
+{
+    (void)gpio;
+    (void)out;
+}
+
+void gpio_set_function(unsigned int gpio, int function)
+{
+    (void)gpio;
+    (void)function;
+}
+
+void gpio_pull_up(unsigned int gpio)
+{
+    (void)gpio;
+}
+
+void gpio_put(unsigned int gpio, bool value)
+{
+    if (gpio == SPI_CS)
+    {
+        // Falling edge starts a frame, rising edge ends it
+        spi_state = (value ? SPI_IDLE : SPI_ADDRESS);
+        if (!value)
+        {
+            sim_transactions++;
+        }
+    }
+}
+
+unsigned int i2c_init(i2c_inst_t *i2c, unsigned int baudrate)
+{
+    (void)i2c;
+    return baudrate;
+}
+
+int i2c_write_blocking(i2c_inst_t *i2c, uint8_t addr, const uint8_t *src, size_t len, bool nostop)
+{
+    (void)nostop;
+    if (i2c != i2c1 || addr != ADDR || len == 0)
+    {
+        sim_bus_errors++;
+        return -1;
+    }
+    sim_transactions++;
+    pointer = src[0];
+    // Multiple writes are (register, value) pairs
+    for (size_t i = 0; i + 1 < len; i += 2)
+    {
+        sim_write(src[i], src[i + 1]);
+    }
+    return (int)len;
+}
+
+int i2c_read_blocking(i2c_inst_t *i2c, uint8_t addr, uint8_t *dst, size_t len, bool nostop)
+{
+    (void)nostop;
+    if (i2c != i2c1 || addr != ADDR)
+    {
+        sim_bus_errors++;
+        return -1;
+    }
+    sim_transactions++;
+    for (size_t i = 0; i < len; i++)
+    {
+        dst[i] = sim_regs[pointer++];
+    }
+    return (int)len;
+}
+
+unsigned int spi_init(spi_inst_t *spi, unsigned int baudrate)
+{
+    (void)spi;
+    return baudrate;
+}
+
+void spi_set_format(spi_inst_t *spi, unsigned int data_bits, spi_cpol_t cpol, spi_cpha_t cpha, spi_order_t order)
+{
+    (void)spi;
+    (void)data_bits;
+    (void)cpol;
+    (void)cpha;
+    (void)order;
+}
+
+int spi_write_blocking(spi_inst_t *spi, const uint8_t *src, size_t len)
+{
+    if (spi != spi0 || spi_state == SPI_IDLE)
+    {
+        sim_bus_errors++;
+        return -1;
+    }
+    for (size_t i = 0; i < len; i++)
+    {
+        switch (spi_state)
+        {
+        case SPI_ADDRESS:
+            // Only 7 address bits on SPI, the register is the address with bit 7 set
+            pointer = src[i] | 0x80;
+            spi_state = (src[i] & 0x80 ? SPI_READ : SPI_WRITE);
+            break;
+        case SPI_WRITE:
+            sim_write(pointer, src[i]);
+            spi_state = SPI_ADDRESS; // Multiple writes are (address, value) pairs
+            break;
+        default:
+            break; // Clocked out during a read, ignored
+        }
+    }
+    return (int)len;
+}
+
+int spi_read_blocking(spi_inst_t *spi, uint8_t repeated_tx_data, uint8_t *dst, size_t len)
+{
+    (void)repeated_tx_data;
+    if (spi != spi0 || spi_state != SPI_READ)
+    {
+        sim_bus_errors++;
+        return -1;
+    }
+    for (size_t i = 0; i < len; i++)
+    {
+        dst[i] = sim_regs[pointer++];
+    }
+    return (int)len;
+}
@@ -0,0 +1,15 @@
+#ifndef BME280_SIM_H
+#define BME280_SIM_H
+
+#include <stdint.h>
+
+// Simulated BME280 : 256-byte register file behind the I2C and 4-wire SPI bus functions.
+
+extern uint8_t sim_regs[256];
+extern uint32_t sim_resets;      // 0xB6 written to RESET_REG
+extern uint32_t sim_bus_errors;  // wrong I2C address, SPI transfer without chip select, read in write mode
+extern uint32_t sim_transactions;
+
+void sim_power_on(void);
+
+#endif
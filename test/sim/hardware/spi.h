@@ -0,0 +1,37 @@
+#ifndef SIM_HARDWARE_SPI_H
+#define SIM_HARDWARE_SPI_H
+
+#include "pico/stdlib.h"
+
+typedef struct
+{
+    int index;
+} spi_inst_t;
+
+typedef enum
+{
+    SPI_CPOL_0,
+    SPI_CPOL_1
+} spi_cpol_t;
+
+typedef enum
+{
+    SPI_CPHA_0,
+    SPI_CPHA_1
+} spi_cpha_t;
+
+typedef enum
+{
+    SPI_LSB_FIRST,
+    SPI_MSB_FIRST
+} spi_order_t;
+
+extern spi_inst_t sim_spi0;
+#define spi0 (&sim_spi0)
+
+unsigned int spi_init(spi_inst_t *spi, unsigned int baudrate);
+void spi_set_format(spi_inst_t *spi, unsigned int data_bits, spi_cpol_t cpol, spi_cpha_t cpha, spi_order_t order);
+int spi_write_blocking(spi_inst_t *spi, const uint8_t *src, size_t len);
+int spi_read_blocking(spi_inst_t *spi, uint8_t repeated_tx_data, uint8_t *dst, size_t len);
+
+#endif
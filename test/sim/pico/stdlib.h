@@ -0,0 +1,25 @@
+#ifndef SIM_PICO_STDLIB_H
+#define SIM_PICO_STDLIB_H
+
+// Host stand-in for the Pico SDK, only what the driver uses. Bus and GPIO calls
+// are implemented by the simulated sensor in bme280_sim.c.
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+
+#define _u(x) x##u
+
+#define GPIO_FUNC_SPI 1
+#define GPIO_FUNC_I2C 3
+#define GPIO_OUT 1
+
+bool stdio_init_all(void);
+void gpio_init(unsigned int gpio);
+void gpio_set_dir(unsigned int gpio, bool out);
+void gpio_put(unsigned int gpio, bool value);
+void gpio_set_function(unsigned int gpio, int function);
+void gpio_pull_up(unsigned int gpio);
+
+#endif
@@ -0,0 +1,158 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <time.h>
+#include "BME280_compensation.h"
+
+// Compensation against the datasheet example and its double precision formulas,
+// batch passes against the single sample path, and host throughput.
+
+#define BATCH_SIZE 4096
+#define THROUGHPUT_ROUNDS 2000
+
+static int failures = 0;
+
+static void check(const char *name, int condition)
+{
+    printf("%-48s %s\n", name, condition ? "ok" : "FAIL");
+    if (!condition)
+    {
+        failures++;
+    }
+}
+
+// Datasheet example for temperature and pressure (same block as test_transport.c)
+static const bme280_calib_t calib = {
+    27504, 26435, -1000,
+    36477, -10685, 3024, 2855, 140, -7, 15500, -14600, 6000,
+    75, 362, 0, 324, -5, 30};
+
+// Double precision formulas of the datasheet (section 8.1)
+static double reference_t_fine(int32_t adc_T)
+{
+    double var1 = (adc_T / 16384.0 - calib.dig_T1 / 1024.0) * calib.dig_T2;
+    double var2 = (adc_T / 131072.0 - calib.dig_T1 / 8192.0) * (adc_T / 131072.0 - calib.dig_T1 / 8192.0) * calib.dig_T3;
+    return var1 + var2;
+}
+
+static double reference_pressure(int32_t adc_P, double t_fine)
+{
+    double var1 = t_fine / 2.0 - 64000.0;
+    double var2 = var1 * var1 * calib.dig_P6 / 32768.0;
+    var2 = var2 + var1 * calib.dig_P5 * 2.0;
+    var2 = var2 / 4.0 + calib.dig_P4 * 65536.0;
+    var1 = (calib.dig_P3 * var1 * var1 / 524288.0 + calib.dig_P2 * var1) / 524288.0;
+    var1 = (1.0 + var1 / 32768.0) * calib.dig_P1;
+    double pressure = 1048576.0 - adc_P;
+    pressure = (pressure - var2 / 4096.0) * 6250.0 / var1;
+    var1 = calib.dig_P9 * pressure * pressure / 2147483648.0;
+    var2 = pressure * calib.dig_P8 / 32768.0;
+    return pressure + (var1 + var2 + calib.dig_P7) / 16.0;
+}
+
+static double reference_humidity(int32_t adc_H, double t_fine)
+{
+    double humidity = t_fine - 76800.0;
+    humidity = (adc_H - (calib.dig_H4 * 64.0 + calib.dig_H5 / 16384.0 * humidity)) *
+               (calib.dig_H2 / 65536.0 * (1.0 + calib.dig_H6 / 67108864.0 * humidity * (1.0 + calib.dig_H3 / 67108864.0 * humidity)));
+    humidity = humidity * (1.0 - calib.dig_H1 * humidity / 524288.0);
+    return (humidity > 100.0 ? 100.0 : (humidity < 0.0 ? 0.0 : humidity));
+}
+
+static double seconds()
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec * 1e-9;
+}
+
+static int32_t adc_T[BATCH_SIZE], adc_P[BATCH_SIZE], adc_H[BATCH_SIZE];
+static int32_t t_fine[BATCH_SIZE], temperature[BATCH_SIZE];
+static uint32_t pressure[BATCH_SIZE], humidity[BATCH_SIZE];
+
+int main()
+{
+    // Datasheet example : 25.08 °C, 100653.25 Pa
+    bme280_raw_t raw = {519888, 415148, 0x6A5B};
+    bme280_sample_t sample;
+    compensate_sample(&calib, &raw, &sample);
+    check("datasheet t_fine", compensate_t_fine(&calib, raw.adc_T) == 128422);
+    check("datasheet temperature (2508)", sample.temperature == 2508);
+    check("datasheet pressure (25767233)", sample.pressure == 25767233);
+    check("humidity (37450, 36.57 %)", sample.humidity == 37450);
+
+    // Sweep against the double precision formulas, t_fine from about -45 °C to 85 °C
+    double error_temperature = 0, error_pressure = 0, error_humidity = 0;
+    for (int32_t t = 330000; t <= 650000; t += 1001)
+    {
+        double fine = reference_t_fine(t);
+        int32_t t_fine_int = compensate_t_fine(&calib, t);
+        double error = fabs(compensate_temperature(t_fine_int) / 100.0 - fine / 5120.0);
+        error_temperature = (error > error_temperature ? error : error_temperature);
+        for (int32_t p = 250000; p <= 650000; p += 20011)
+        {
+            error = fabs(compensate_pressure(&calib, p, t_fine_int) / 256.0 - reference_pressure(p, fine));
+            error_pressure = (error > error_pressure ? error : error_pressure);
+        }
+        for (int32_t h = 20000; h <= 40000; h += 1009)
+        {
+            error = fabs(compensate_humidity(&calib, h, t_fine_int) / 1024.0 - reference_humidity(h, fine));
+            error_humidity = (error > error_humidity ? error : error_humidity);
+        }
+    }
+    printf("max error : %.4f °C, %.3f Pa, %.4f %%\n", error_temperature, error_pressure, error_humidity);
+    check("temperature against double formula (0.01 °C)", error_temperature <= 0.01);
+    check("pressure against double formula (1 Pa)", error_pressure <= 1.0);
+    check("humidity against double formula (0.05 %)", error_humidity <= 0.05);
+
+    // Batch passes against the single sample path
+    srand(1);
+    for (int i = 0; i < BATCH_SIZE; i++)
+    {
+        adc_T[i] = 330000 + rand() % 320000;
+        adc_P[i] = 250000 + rand() % 400000;
+        adc_H[i] = 20000 + rand() % 20000;
+    }
+    bme280_raw_batch_t batch = {adc_T, adc_P, adc_H, BATCH_SIZE};
+    compensate_batch(&calib, &batch, t_fine, temperature, pressure, humidity);
+    int same = 1;
+    for (int i = 0; i < BATCH_SIZE; i++)
+    {
+        bme280_raw_t one = {adc_T[i], adc_P[i], adc_H[i]};
+        compensate_sample(&calib, &one, &sample);
+        same &= (t_fine[i] == compensate_t_fine(&calib, adc_T[i]) && temperature[i] == sample.temperature &&
+                 pressure[i] == sample.pressure && humidity[i] == sample.humidity);
+    }
+    check("batch matches single samples", same);
+
+    // NULL outputs skip their pass and leave the buffers untouched
+    for (int i = 0; i < BATCH_SIZE; i++)
+    {
+        temperature[i] = -1;
+        pressure[i] = 0xFFFFFFFF;
+        humidity[i] = 0xFFFFFFFF;
+    }
+    compensate_batch(&calib, &batch, t_fine, NULL, NULL, humidity);
+    same = 1;
+    for (int i = 0; i < BATCH_SIZE; i++)
+    {
+        bme280_raw_t one = {adc_T[i], adc_P[i], adc_H[i]};
+        compensate_sample(&calib, &one, &sample);
+        same &= (temperature[i] == -1 && pressure[i] == 0xFFFFFFFF && humidity[i] == sample.humidity);
+    }
+    check("NULL outputs skip their pass", same);
+    compensate_temperature_batch(&calib, adc_T, t_fine, NULL, BATCH_SIZE);
+    check("temperature pass with t_fine only", t_fine[BATCH_SIZE - 1] == compensate_t_fine(&calib, adc_T[BATCH_SIZE - 1]));
+
+    // Host throughput of the three passes (reported, not checked : depends on the machine)
+    double start = seconds();
+    for (int round = 0; round < THROUGHPUT_ROUNDS; round++)
+    {
+        compensate_batch(&calib, &batch, t_fine, temperature, pressure, humidity);
+    }
+    double elapsed = seconds() - start;
+    printf("throughput : %.1f Msamples/s (temperature + pressure + humidity)\n",
+           (double)BATCH_SIZE * THROUGHPUT_ROUNDS / elapsed / 1e6);
+
+    return (failures == 0 ? 0 : 1);
+}
@@ -0,0 +1,93 @@
+#include <stdio.h>
+#include <math.h>
+#include "BME280_derived.h"
+
+// Sweeps the derived quantities against double precision references
+// and checks the error bounds given in the BME280_derived.c comments.
+
+static int failures = 0;
+
+static void check_bound(const char *name, double max_error, double bound)
+{
+    printf("%-28s max error %.4g (bound %.4g)\n", name, max_error, bound);
+    if (max_error > bound)
+    {
+        printf("FAIL : %s\n", name);
+        failures++;
+    }
+}
+
+static double magnus(double temperature)
+{
+    return 611.2 * exp(17.62 * temperature / (243.12 + temperature));
+}
+
+int main()
+{
+    double error_altitude = 0, error_sea_level = 0, error_vapour = 0, error_dew = 0, error_absolute = 0;
+
+    // Altitude in mm, over the table range (p / p0 in [0.25, 1.25[)
+    for (uint32_t pressure = 30000 * 256; pressure <= 110000 * 256; pressure += 97)
+    {
+        double ratio = pressure / 256.0 / SEA_LEVEL_PRESSURE_PA;
+        double reference = 44330.0 * (1 - pow(ratio, 1 / 5.255)) * 1000;
+        double error = fabs(derive_altitude_mm(pressure, SEA_LEVEL_PRESSURE_PA) - reference);
+        error_altitude = (error > error_altitude ? error : error_altitude);
+    }
+
+    // Sea level pressure in Pa, stations from -1900 m to 3000 m
+    for (int32_t altitude = -1900000; altitude <= 3000000; altitude += 997)
+    {
+        double reference = 100000.0 / pow(1 - altitude / 1000.0 / 44330, 5.255);
+        double error = fabs(derive_sea_level_pressure(100000 * 256, altitude) / 256.0 - reference);
+        error_sea_level = (error > error_sea_level ? error : error_sea_level);
+    }
+
+    for (int32_t temperature = -4000; temperature <= 8500; temperature += 7)
+    {
+        double saturation = magnus(temperature / 100.0);
+        double error = fabs(derive_saturation_vapour_pressure(temperature) / 256.0 - saturation) / saturation;
+        error_vapour = (error > error_vapour ? error : error_vapour);
+
+        for (uint32_t humidity = 1024; humidity <= 102400; humidity += 1021)
+        {
+            double vapour = saturation * humidity / 102400.0;
+            double gamma = log(vapour / 611.2);
+            double dew_point = 243.12 * gamma / (17.62 - gamma);
+            if (dew_point >= -40)
+            {
+                error = fabs(derive_dew_point(temperature, humidity) / 100.0 - dew_point);
+                error_dew = (error > error_dew ? error : error_dew);
+            }
+
+            double absolute = vapour / (461.5 * (temperature / 100.0 + 273.15)) * 1e6;
+            if (absolute >= 1000)
+            {
+                error = fabs(derive_absolute_humidity(temperature, humidity) - absolute) / absolute;
+                error_absolute = (error > error_absolute ? error : error_absolute);
+            }
+        }
+    }
+
+    check_bound("altitude (mm)", error_altitude, 200);
+    check_bound("sea level pressure (Pa)", error_sea_level, 0.5);
+    check_bound("saturation vapour (relative)", error_vapour, 0.0012);
+    check_bound("dew point (°C)", error_dew, 0.05);
+    check_bound("absolute humidity (relative)", error_absolute, 0.001);
+
+    // Out of range reference pressure : clamped to the table, no wrap-around
+    int32_t clamped = derive_altitude_mm(100000 * 256, 100);
+    printf("%-28s %ld mm\n", "altitude, p0 = 100 Pa", (long)clamped);
+    if (clamped != derive_altitude_mm(125 * 256, 100))
+    {
+        printf("FAIL : altitude not clamped\n");
+        failures++;
+    }
+    if (derive_altitude_mm(100000 * 256, 0) != 0)
+    {
+        printf("FAIL : altitude with p0 = 0\n");
+        failures++;
+    }
+
+    return (failures == 0 ? 0 : 1);
+}
@@ -0,0 +1,109 @@
+#include <stdio.h>
+#include "BME280_i2c.h"
+#include "bme280_sim.h"
+
+// Driver register access against the simulated sensor, built once per transport
+// (TRANSPORT=TRANSPORT_I2C and TRANSPORT=TRANSPORT_SPI).
+
+static int failures = 0;
+
+static void check(const char *name, int condition)
+{
+    printf("%-44s %s\n", name, condition ? "ok" : "FAIL");
+    if (!condition)
+    {
+        failures++;
+    }
+}
+
+static void put16(uint8_t reg, uint16_t value)
+{
+    sim_regs[reg] = (uint8_t)(value & 0xFF);
+    sim_regs[reg + 1] = (uint8_t)(value >> 8);
+}
+
+// Datasheet example for temperature and pressure, negative dig_H5 to check the 12 bits sign extension
+static const bme280_calib_t expected = {
+    27504, 26435, -1000,
+    36477, -10685, 3024, 2855, 140, -7, 15500, -14600, 6000,
+    75, 362, 0, 324, -5, 30};
+
+static void load_calibration()
+{
+    const int16_t *pressure = &expected.dig_P2;
+    put16(CALIB00_REG, expected.dig_T1);
+    put16(CALIB02_REG, (uint16_t)expected.dig_T2);
+    put16(CALIB04_REG, (uint16_t)expected.dig_T3);
+    put16(CALIB06_REG, expected.dig_P1);
+    for (int i = 0; i < 8; i++)
+    {
+        put16((uint8_t)(CALIB08_REG + 2 * i), (uint16_t)pressure[i]);
+    }
+    sim_regs[CALIB25_REG] = expected.dig_H1;
+    put16(CALIB26_REG, (uint16_t)expected.dig_H2);
+    sim_regs[CALIB28_REG] = expected.dig_H3;
+    sim_regs[CALIB29_REG] = (uint8_t)(expected.dig_H4 >> 4);
+    sim_regs[CALIB30_REG] = (uint8_t)((expected.dig_H4 & 0x0F) | ((expected.dig_H5 & 0x0F) << 4));
+    sim_regs[CALIB31_REG] = (uint8_t)(expected.dig_H5 >> 4);
+    sim_regs[CALIB32_REG] = (uint8_t)expected.dig_H6;
+}
+
+int main()
+{
+    bme280_calib_t calib;
+    bme280_raw_t raw;
+
+    printf("Transport : %s\n", TRANSPORT == TRANSPORT_SPI ? "SPI" : "I2C");
+    sim_power_on();
+    init();
+    check("chip ID", read_reg(ID_REG) == BME_280_ID);
+
+    // Calibration : two bursts, every field decoded
+    load_calibration();
+    read_calibration(&calib);
+    check("calibration temperature", calib.dig_T1 == expected.dig_T1 && calib.dig_T2 == expected.dig_T2 && calib.dig_T3 == expected.dig_T3);
+    check("calibration pressure", calib.dig_P1 == expected.dig_P1 && calib.dig_P2 == expected.dig_P2 && calib.dig_P5 == expected.dig_P5 && calib.dig_P9 == expected.dig_P9);
+    check("calibration humidity", calib.dig_H1 == expected.dig_H1 && calib.dig_H2 == expected.dig_H2 && calib.dig_H3 == expected.dig_H3 &&
+                                      calib.dig_H4 == expected.dig_H4 && calib.dig_H5 == expected.dig_H5 && calib.dig_H6 == expected.dig_H6);
+
+    // Burst read of the data registers : adc_P = 415148, adc_T = 519888, adc_H = 0x6A5B
+    uint8_t data[8] = {0x65, 0x5A, 0xC0, 0x7E, 0xED, 0x00, 0x6A, 0x5B};
+    for (int i = 0; i < 8; i++)
+    {
+        sim_regs[PRESS_MSB_REG + i] = data[i];
+    }
+    uint32_t transactions = sim_transactions;
+    get_raw_burst(&raw);
+    check("burst read in one transfer", sim_transactions - transactions <= 2);
+    check("burst read values", raw.adc_P == 415148 && raw.adc_T == 519888 && raw.adc_H == 0x6A5B);
+    check("single channel reads", get_raw_press() == 415148 && get_raw_temp() == 519888 && get_raw_humidity() == 0x6A5B);
+    check("compensated temperature", get_compensate_temperature() == 2508);
+
+    // Read-modify-write setters keep the other fields
+    set_temperature_oversampling(2);
+    set_pressure_oversampling(4);
+    set_mode(FORCED_MODE);
+    check("CTRL_MEAS (x2, x4, forced)", sim_regs[CTRL_MEAS_REG] == (TEMP_OVERSAMPLING_2_VALUE | PRESS_OVERSAMPLING_4_VALUE | FORCED_MODE));
+    set_mode(SLEEP_MODE);
+    check("CTRL_MEAS back to sleep", sim_regs[CTRL_MEAS_REG] == (TEMP_OVERSAMPLING_2_VALUE | PRESS_OVERSAMPLING_4_VALUE));
+    set_humidity_oversampling(16);
+    check("CTRL_HUM (x16)", sim_regs[CTRL_HUM_REG] == HUM_OVERSAMPLING_16_VALUE);
+    set_standby(STANDBY_250_ms);
+    set_iir_coefficent(FILTER_COEFFICIENT_8);
+    enable_spi();
+#if TRANSPORT == TRANSPORT_SPI
+    check("CONFIG spi3w refused over 4-wire SPI", sim_regs[CONFIG_REG] == (STANDBY_250_ms | FILTER_COEFFICIENT_8));
+#else
+    check("CONFIG (250 ms, filter 8, spi3w)", sim_regs[CONFIG_REG] == (STANDBY_250_ms | FILTER_COEFFICIENT_8 | 0x01));
+#endif
+    disable_spi();
+    check("CONFIG spi3w cleared", sim_regs[CONFIG_REG] == (STANDBY_250_ms | FILTER_COEFFICIENT_8));
+    check("measurement time (x2, x4, x16)", get_measurement_time_us() == 1250 + 2 * 2300 + 4 * 2300 + 575 + 16 * 2300 + 575);
+
+    // Reset goes to RESET_REG and leaves the ID alone
+    reset();
+    check("reset written to RESET_REG", sim_resets == 1 && read_reg(ID_REG) == BME_280_ID);
+
+    check("no bus error", sim_bus_errors == 0);
+    return (failures == 0 ? 0 : 1);
+}
@@ -0,0 +1,101 @@
+#include <stdio.h>
+#include "BME280_trigger.h"
+
+// Scenarios of the trigger engine : held out of range value, sensor noise, real ramp.
+
+#define FAST_PERIOD_MS 100
+#define SLOW_PERIOD_MS 1000
+#define QUIET_SAMPLES 10
+#define SLOPE_WINDOW_MS 1000
+
+static int failures = 0;
+
+static void check(const char *name, int condition)
+{
+    printf("%-48s %s\n", name, condition ? "ok" : "FAIL");
+    if (!condition)
+    {
+        failures++;
+    }
+}
+
+// Feed samples for duration_ms at the engine's own rate, value given by a callback
+static void run(trigger_engine_t *engine, uint32_t *time_ms, uint32_t duration_ms, int32_t (*pressure)(uint32_t), int32_t temperature)
+{
+    uint32_t end = *time_ms + duration_ms;
+    while (*time_ms < end)
+    {
+        bme280_sample_t sample = {temperature, (uint32_t)pressure(*time_ms), 50 * 1024};
+        trigger_adapt_rate(engine, trigger_evaluate(engine, &sample, *time_ms));
+        *time_ms += engine->period_ms;
+    }
+}
+
+static int32_t flat(uint32_t time_ms)
+{
+    (void)time_ms;
+    return 100000 * 256;
+}
+
+// +-8 Pa alternating steps : above 50 Pa/s between two samples 100 ms apart
+static int32_t noisy(uint32_t time_ms)
+{
+    return 100000 * 256 + ((time_ms / FAST_PERIOD_MS) & 1 ? 8 * 256 : -8 * 256);
+}
+
+// 200 Pa/s drop
+static int32_t ramp(uint32_t time_ms)
+{
+    return 100000 * 256 - (int32_t)(time_ms * 256 / 5);
+}
+
+static void setup(trigger_engine_t *engine)
+{
+    trigger_init(engine, FAST_PERIOD_MS, SLOW_PERIOD_MS, QUIET_SAMPLES, SLOPE_WINDOW_MS);
+    trigger_set_channel(engine, TRIGGER_TEMPERATURE, 0, 3500, 50, 100);
+    trigger_set_channel(engine, TRIGGER_PRESSURE, 0, INT32_MAX, 0, 50 * 256);
+}
+
+int main()
+{
+    trigger_engine_t engine;
+    uint32_t time_ms = 0;
+
+    // Temperature held below the low threshold : one trigger, then back-off (slope disabled, the step is sharp)
+    setup(&engine);
+    trigger_set_channel(&engine, TRIGGER_TEMPERATURE, 0, 3500, 50, 0);
+    run(&engine, &time_ms, 5000, flat, 2000);
+    run(&engine, &time_ms, 100, flat, -500);
+    check("crossing switches to the fast period", trigger_is_fast(&engine));
+    run(&engine, &time_ms, 60000, flat, -500);
+    check("held out of range value backs off to the slow period", engine.period_ms == SLOW_PERIOD_MS);
+    check("held out of range value reported in the status", trigger_status(&engine) == (1 << TRIGGER_TEMPERATURE));
+    check("held out of range value counted once", engine.events == 1);
+    run(&engine, &time_ms, 5000, flat, 2000);
+    check("status cleared back inside the hysteresis", trigger_status(&engine) == 0);
+
+    // Sensor noise at the fast period does not fire the slope
+    setup(&engine);
+    time_ms = 0;
+    engine.period_ms = FAST_PERIOD_MS;
+    run(&engine, &time_ms, 30000, noisy, 2000);
+    check("noise does not fire the slope", engine.events == 0 && engine.period_ms == SLOW_PERIOD_MS);
+
+    // Real pressure ramp : fast while it lasts, one event for the whole ramp
+    setup(&engine);
+    time_ms = 0;
+    run(&engine, &time_ms, 5000, flat, 2000);
+    uint32_t ramp_start = time_ms;
+    uint32_t end = time_ms + 10000;
+    while (time_ms < end)
+    {
+        bme280_sample_t sample = {2000, (uint32_t)ramp(time_ms - ramp_start), 50 * 1024};
+        trigger_adapt_rate(&engine, trigger_evaluate(&engine, &sample, time_ms));
+        time_ms += engine.period_ms;
+    }
+    check("ramp keeps the fast period", trigger_is_fast(&engine));
+    check("ramp counted once (rising edge)", engine.events == 1);
+    check("samples saved counted", engine.samples_saved > 0);
+
+    return (failures == 0 ? 0 : 1);
+}